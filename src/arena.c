@@ -0,0 +1,178 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+// all allocations are aligned to this
+#define ARENA_ALIGN 8
+#define ARENA_ROUND(x) (((x) + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1))
+#define ARENA_HDR ARENA_ROUND(sizeof(struct arena_chunk))
+
+// -----------------------------------------------------------------------
+void arena_init(struct arena *a, size_t node_size)
+{
+	memset(a, 0, sizeof(struct arena));
+	a->node_size = ARENA_ROUND(node_size);
+}
+
+// -----------------------------------------------------------------------
+// Free all the memory at once. Statistics are kept.
+void arena_release(struct arena *a)
+{
+	struct arena_chunk *c = a->chunks;
+
+	while (c) {
+		struct arena_chunk *next = c->next;
+		free(c);
+		c = next;
+	}
+
+	a->chunks = NULL;
+	a->free_nodes = NULL;
+	a->nodes = 0;
+}
+
+// -----------------------------------------------------------------------
+// Move all the memory (and statistics) from src arena to dst.
+// Src is left empty.
+void arena_merge(struct arena *dst, struct arena *src)
+{
+	struct arena_chunk *c = src->chunks;
+
+	// src chunks go after the current dst chunk
+	if (c) {
+		while (c->next) {
+			c = c->next;
+		}
+		if (dst->chunks) {
+			c->next = dst->chunks->next;
+			dst->chunks->next = src->chunks;
+		} else {
+			dst->chunks = src->chunks;
+		}
+	}
+
+	// nodes dropped in src may come from either arena
+	void *node = src->free_nodes;
+	if (node) {
+		while (*(void**) node) {
+			node = *(void**) node;
+		}
+		*(void**) node = dst->free_nodes;
+		dst->free_nodes = src->free_nodes;
+	}
+
+	dst->bytes += src->bytes;
+	dst->used += src->used;
+	dst->nodes += src->nodes; // may be "negative" if src only dropped nodes
+	dst->nodes_total += src->nodes_total;
+	dst->nodes_reused += src->nodes_reused;
+	if (dst->nodes > dst->nodes_peak) {
+		dst->nodes_peak = dst->nodes;
+	}
+
+	arena_init(src, src->node_size);
+}
+
+// -----------------------------------------------------------------------
+void * arena_alloc(struct arena *a, size_t size)
+{
+	struct arena_chunk *c = a->chunks;
+
+	size = ARENA_ROUND(size ? size : 1);
+
+	if (!c || (c->size - c->used < size)) {
+		size_t csize = ARENA_HDR + size;
+		if (csize < ARENA_CHUNK_SIZE) {
+			csize = ARENA_CHUNK_SIZE;
+		}
+		c = malloc(csize);
+		if (!c) {
+			return NULL;
+		}
+		c->size = csize;
+		c->used = ARENA_HDR;
+		// oversized allocations don't replace current chunk
+		if (a->chunks && (csize > ARENA_CHUNK_SIZE)) {
+			c->next = a->chunks->next;
+			a->chunks->next = c;
+		} else {
+			c->next = a->chunks;
+			a->chunks = c;
+		}
+		a->bytes += csize;
+	}
+
+	void *p = (char*) c + c->used;
+	c->used += size;
+	a->used += size;
+
+	return p;
+}
+
+// -----------------------------------------------------------------------
+void * arena_memdup(struct arena *a, const void *src, size_t size)
+{
+	void *p = arena_alloc(a, size);
+	if (p) {
+		memcpy(p, src, size);
+	}
+
+	return p;
+}
+
+// -----------------------------------------------------------------------
+// Get a zeroed node, reusing dropped ones first
+void * arena_node_get(struct arena *a)
+{
+	void *node = a->free_nodes;
+
+	if (node) {
+		a->free_nodes = *(void**) node;
+		a->nodes_reused++;
+	} else {
+		node = arena_alloc(a, a->node_size);
+		if (!node) {
+			return NULL;
+		}
+	}
+
+	memset(node, 0, a->node_size);
+
+	a->nodes_total++;
+	a->nodes++;
+	if (a->nodes > a->nodes_peak) {
+		a->nodes_peak = a->nodes;
+	}
+
+	return node;
+}
+
+// -----------------------------------------------------------------------
+void arena_node_put(struct arena *a, void *node)
+{
+	if (!node) return;
+
+	*(void**) node = a->free_nodes;
+	a->free_nodes = node;
+	a->nodes--;
+}
+
+// vim: tabstop=4 autoindent
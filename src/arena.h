@@ -0,0 +1,58 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_CHUNK_SIZE (64 * 1024)
+
+struct arena_chunk {
+	struct arena_chunk *next;
+	size_t size;
+	size_t used;
+};
+
+// Memory arena for a single assembly run.
+// Fixed-size nodes come from the arena and may be returned to a free list
+// for reuse. Any other allocation (strings, data blobs) lives until
+// the arena is released as a whole.
+struct arena {
+	struct arena_chunk *chunks;
+	size_t node_size;
+	void *free_nodes;
+						// Statistics:
+	size_t bytes;		//  * memory reserved for chunks
+	size_t used;		//  * memory handed out
+	size_t nodes;		//  * nodes currently in use
+	size_t nodes_peak;	//  * max. nodes in use at a time
+	size_t nodes_total;	//  * nodes handed out
+	size_t nodes_reused;//  * nodes handed out from the free list
+};
+
+void arena_init(struct arena *a, size_t node_size);
+void arena_release(struct arena *a);
+void arena_merge(struct arena *dst, struct arena *src);
+void * arena_alloc(struct arena *a, size_t size);
+void * arena_memdup(struct arena *a, const void *src, size_t size);
+void * arena_node_get(struct arena *a);
+void arena_node_put(struct arena *a, void *node);
+
+#endif
+
+// vim: tabstop=4 autoindent
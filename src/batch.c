@@ -0,0 +1,319 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "libemas.h"
+#include "batch.h"
+
+#define BATCH_LINE_MAX 4096
+
+struct batch_job {
+	char *input;
+	char *output;
+	FILE *errf;
+	int res;
+	int done;
+};
+
+struct batch {
+	struct batch_job *jobs;
+	int count;
+	int next;
+	struct emas_opts *opts;
+	int otype;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+};
+
+// -----------------------------------------------------------------------
+struct batch * batch_create()
+{
+	struct batch *b = calloc(1, sizeof(struct batch));
+	if (!b) {
+		return NULL;
+	}
+
+	pthread_mutex_init(&b->lock, NULL);
+	pthread_cond_init(&b->cond, NULL);
+
+	return b;
+}
+
+// -----------------------------------------------------------------------
+void batch_destroy(struct batch *b)
+{
+	int i;
+
+	if (!b) return;
+
+	for (i=0 ; i<b->count ; i++) {
+		free(b->jobs[i].input);
+		free(b->jobs[i].output);
+		if (b->jobs[i].errf) fclose(b->jobs[i].errf);
+	}
+	free(b->jobs);
+	pthread_mutex_destroy(&b->lock);
+	pthread_cond_destroy(&b->cond);
+	free(b);
+}
+
+// -----------------------------------------------------------------------
+int batch_add(struct batch *b, char *input, char *output)
+{
+	struct batch_job *jobs = realloc(b->jobs, (b->count+1) * sizeof(struct batch_job));
+	if (!jobs) {
+		return -1;
+	}
+	b->jobs = jobs;
+
+	struct batch_job *job = b->jobs + b->count;
+	memset(job, 0, sizeof(struct batch_job));
+	job->input = strdup(input);
+	if (output) {
+		job->output = strdup(output);
+	}
+	b->count++;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Add sources listed in a response file: one "source [output]" pair
+// per line. Empty lines and lines starting with '#' are skipped.
+int batch_add_list(struct batch *b, char *list_file)
+{
+	char line[BATCH_LINE_MAX+1];
+	int lineno = 0;
+	int res = 0;
+
+	FILE *f = fopen(list_file, "r");
+	if (!f) {
+		fprintf(stderr, "Cannot open response file: '%s'\n", list_file);
+		return -1;
+	}
+
+	while (fgets(line, BATCH_LINE_MAX, f)) {
+		lineno++;
+		char *input = strtok(line, " \t\r\n");
+		if (!input || (*input == '#')) {
+			continue;
+		}
+		char *output = strtok(NULL, " \t\r\n");
+		if (strtok(NULL, " \t\r\n")) {
+			fprintf(stderr, "%s:%d: expected \"source [output]\"\n", list_file, lineno);
+			res = -1;
+			break;
+		}
+		if (batch_add(b, input, output)) {
+			res = -1;
+			break;
+		}
+	}
+
+	fclose(f);
+
+	return res;
+}
+
+// -----------------------------------------------------------------------
+// Output name for a source assembled in batch mode: source name
+// without the extension, with output type suffix for text and object outputs
+static char * batch_output_name(char *input, int otype)
+{
+	char *suffix;
+
+	switch (otype) {
+		case O_DEBUG:
+			suffix = ".debug";
+			break;
+		case O_KEYS:
+			suffix = ".keys";
+			break;
+		case O_OBJ:
+			suffix = ".o";
+			break;
+		case O_SEG:
+			suffix = ".seg";
+			break;
+		case O_LISTING:
+			suffix = ".lst";
+			break;
+		case O_MAP:
+			suffix = ".map";
+			break;
+		case O_LINES:
+			suffix = ".lines";
+			break;
+		default:
+			suffix = "";
+			break;
+	}
+
+	char *name = malloc(strlen(input) + strlen(suffix) + 1);
+	if (!name) {
+		return NULL;
+	}
+	strcpy(name, input);
+	char *dot = strrchr(name, '.');
+	if (dot && !strchr(dot, '/')) {
+		*dot = '\0';
+	}
+	strcat(name, suffix);
+
+	return name;
+}
+
+// -----------------------------------------------------------------------
+static int batch_job_run(struct batch *b, struct emas_ctx *ctx, struct batch_job *job)
+{
+	// diagnostics are buffered so they can be printed in job order
+	job->errf = tmpfile();
+	FILE *errf = job->errf ? job->errf : stderr;
+
+	if (!job->output) {
+		job->output = batch_output_name(job->input, b->otype);
+		if (!job->output) {
+			fprintf(errf, "%s: cannot allocate output name\n", job->input);
+			return 1;
+		}
+	}
+
+	if (!strcmp(job->input, job->output)) {
+		fprintf(errf, "Input and output file names cannot be the same: '%s'\n", job->output);
+		return 1;
+	}
+
+	struct emas_opts opts = *b->opts;
+	opts.errf = errf;
+	struct emas_out out = { b->otype, job->output, NULL };
+
+	return emas_assemble(ctx, job->input, &opts, &out);
+}
+
+// -----------------------------------------------------------------------
+static void * batch_worker(void *ptr)
+{
+	struct batch *b = ptr;
+	int i;
+
+	struct emas_ctx *ctx = emas_create();
+
+	while (1) {
+		pthread_mutex_lock(&b->lock);
+		i = b->next++;
+		pthread_mutex_unlock(&b->lock);
+
+		if (i >= b->count) {
+			break;
+		}
+
+		struct batch_job *job = b->jobs + i;
+		if (ctx) {
+			job->res = batch_job_run(b, ctx, job);
+		} else {
+			fprintf(stderr, "%s: failed to create assembler context\n", job->input);
+			job->res = 1;
+		}
+
+		pthread_mutex_lock(&b->lock);
+		job->done = 1;
+		pthread_cond_broadcast(&b->cond);
+		pthread_mutex_unlock(&b->lock);
+	}
+
+	emas_destroy(ctx);
+
+	return NULL;
+}
+
+// -----------------------------------------------------------------------
+static void batch_flush_diag(struct batch_job *job)
+{
+	char buf[BATCH_LINE_MAX];
+	size_t len;
+
+	if (!job->errf) return;
+
+	rewind(job->errf);
+	while ((len = fread(buf, 1, BATCH_LINE_MAX, job->errf)) > 0) {
+		fwrite(buf, 1, len, stderr);
+	}
+	fclose(job->errf);
+	job->errf = NULL;
+}
+
+// -----------------------------------------------------------------------
+// Assemble all queued sources using 'workers' threads.
+// Diagnostics are printed in the order sources were added.
+// Returns the number of sources that failed to assemble.
+int batch_run(struct batch *b, struct emas_opts *opts, int otype, int workers)
+{
+	int i;
+	int failed = 0;
+	int started = 0;
+
+	b->opts = opts;
+	b->otype = otype;
+	b->next = 0;
+
+	if (workers > b->count) workers = b->count;
+	if (workers < 1) workers = 1;
+
+	pthread_t *threads = calloc(workers, sizeof(pthread_t));
+	if (!threads) {
+		fprintf(stderr, "Failed to allocate worker threads.\n");
+		return b->count;
+	}
+
+	for (i=0 ; i<workers ; i++) {
+		if (pthread_create(threads+i, NULL, batch_worker, b)) {
+			break;
+		}
+		started++;
+	}
+
+	if (!started) {
+		// no threads available, do the work here
+		batch_worker(b);
+	}
+
+	for (i=0 ; i<b->count ; i++) {
+		pthread_mutex_lock(&b->lock);
+		while (!b->jobs[i].done) {
+			pthread_cond_wait(&b->cond, &b->lock);
+		}
+		pthread_mutex_unlock(&b->lock);
+
+		batch_flush_diag(b->jobs+i);
+		if (b->jobs[i].res) {
+			failed++;
+		}
+	}
+
+	for (i=0 ; i<started ; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	free(threads);
+
+	return failed;
+}
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,33 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "libemas.h"
+
+struct batch;
+
+struct batch * batch_create();
+void batch_destroy(struct batch *b);
+int batch_add(struct batch *b, char *input, char *output);
+int batch_add_list(struct batch *b, char *list_file);
+int batch_run(struct batch *b, struct emas_opts *opts, int otype, int workers);
+
+#endif
+
+// vim: tabstop=4 autoindent
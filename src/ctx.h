@@ -0,0 +1,87 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef CTX_H
+#define CTX_H
+
+#include <stdio.h>
+
+#include "arena.h"
+#include "dh.h"
+#include "st.h"
+#include "prog.h"
+#include "expr.h"
+#include "lexer_utils.h"
+#include "parser.h"
+
+struct emas_out;
+
+// Everything a single assembly run needs. Contexts are independent
+// of each other, only the keyword table is shared (read-only).
+struct emas_ctx {
+						// Lexer state:
+	void *scanner;		//  * reentrant flex scanner
+	YYLTYPE lloc;		//  * location of the last matched token
+	struct loc loc_stack[INCLUDE_MAX+1];
+	int loc_pos;
+	struct st *inc_paths;
+	char *cwd;			//  * base for relative paths (NULL = process cwd)
+	char *source;		//  * main source file (NULL if read from a stream)
+	struct emas_out *outs;	//  * additional outputs
+	int out_count;
+	FILE * (*inc_open)(const char *path, void *data);
+	void *inc_open_data;
+	struct dh_table *atoms;	//  * interned names and file names
+	char *cur_label;
+	char str_buf[STR_MAX+1];
+	int str_len;
+	int lexer_err_reported;
+						// Program state:
+	struct arena arena;	//  * all syntax tree nodes for the run
+	struct st_loc *locs;//  * node locations
+	uint32_t loc_count;
+	uint32_t loc_cap;
+	struct dh_table *sym;
+	struct st *program;
+	struct st *entry;
+	int cpu;
+	int ic;
+	int ic_max;
+	struct st **stmts;	//  * top-level statements in program order (built by layout)
+	int stmt_count;
+	int stmt_cap;
+	struct fixup *fixups;	//  * nodes waiting for symbols defined later
+	int fixup_count;
+	int fixup_cap;
+	struct dh_elem *unresolved;	//  * symbol the last evaluation stopped at
+	struct expr_state expr;	//  * expression evaluator buffers
+	int sym_readonly;	//  * don't evaluate symbol definitions (encoding workers)
+	int jobs;			//  * worker threads for encoding
+	int relocatable;	//  * assemble a module to be linked with others
+	int externs;		//  * undefined global symbols are external (relocatable modules)
+						// Diagnostics:
+	FILE *errf;			//  * where errors (and debug information) go
+	char aerr[MAX_ERRLEN+1];
+	int aadebug;
+	int sym_stats;
+};
+
+char * ctx_path(struct emas_ctx *ctx, char *path);
+
+#endif
+
+// vim: tabstop=4 autoindent
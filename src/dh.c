@@ -24,82 +24,193 @@
 #include "dh.h"
 #include "st.h"
 
+#define DH_SIZE_MIN 16
+// grow when more than 3/4 of slots are taken
+#define DH_LOAD_MAX(size) ((size) - ((size) >> 2))
+
 // -----------------------------------------------------------------------
 struct dh_table * dh_create(int size, int case_sens)
 {
+	unsigned s = DH_SIZE_MIN;
+
 	struct dh_table *dh = malloc(sizeof(struct dh_table));
 	if (!dh) {
 		return NULL;
 	}
 
-	dh->slots = calloc(size, sizeof(struct dh_elem));
+	while (s < (unsigned) size) {
+		s <<= 1;
+	}
+
+	dh->slots = calloc(s, sizeof(struct dh_slot));
 	if (!dh->slots) {
 		free(dh);
 		return NULL;
 	}
-	dh->size = size;
-	if (case_sens) {
-		dh->str_cmp = strcmp;
-		dh->case_sens = 1;
+	dh->size = s;
+	dh->count = 0;
+	dh->case_sens = case_sens ? 1 : 0;
+	dh->key_offset = 0;
+
+	return dh;
+}
+
+// -----------------------------------------------------------------------
+// Functions below get case sensitivity as a constant, so each
+// variant is specialized when inlined
+static inline unsigned dh_hash(const char *str, const int case_sens)
+{
+	unsigned v = 2166136261u; // FNV-1a
+
+	while (*str) {
+		v ^= (unsigned char) (case_sens ? *str : tolower((unsigned char) *str));
+		v *= 16777619u;
+		str++;
+	}
+
+	return v;
+}
+
+// -----------------------------------------------------------------------
+static inline int dh_name_eq(const char *s1, const char *s2, const int case_sens)
+{
+	return case_sens ? !strcmp(s1, s2) : !strcasecmp(s1, s2);
+}
+
+// -----------------------------------------------------------------------
+// Distance of the element in slot 'pos' from its home slot
+static inline unsigned dh_dist(unsigned size, unsigned hash, unsigned pos)
+{
+	return (pos - hash) & (size - 1);
+}
+
+// -----------------------------------------------------------------------
+// Get slot number of an element, -1 if not found
+static inline int dh_find(struct dh_table *dh, const char *name, unsigned hash, const int case_sens)
+{
+	unsigned pos = hash & (dh->size - 1);
+	unsigned dist = 0;
+
+	while (1) {
+		struct dh_slot *s = dh->slots + pos;
+		// empty slot or an element closer to its home than the one
+		// we're looking for would be: no such element in the table
+		if (!s->elem || (dh_dist(dh->size, s->hash, pos) < dist)) {
+			return -1;
+		}
+		if ((s->hash == hash) && dh_name_eq(name, s->elem->name + dh->key_offset, case_sens)) {
+			return pos;
+		}
+		pos = (pos + 1) & (dh->size - 1);
+		dist++;
+	}
+}
+
+// -----------------------------------------------------------------------
+static int dh_lookup(struct dh_table *dh, const char *name, unsigned *hash)
+{
+	name += dh->key_offset;
+	if (dh->case_sens) {
+		*hash = dh_hash(name, 1);
+		return dh_find(dh, name, *hash, 1);
 	} else {
-		dh->str_cmp = strcasecmp;
-		dh->case_sens = 0;
+		*hash = dh_hash(name, 0);
+		return dh_find(dh, name, *hash, 0);
 	}
+}
 
-	return dh;
+// -----------------------------------------------------------------------
+// Put an element into the slot table (element is known not to be there)
+static void dh_insert(struct dh_slot *slots, unsigned size, unsigned hash, struct dh_elem *elem)
+{
+	struct dh_slot cur = { hash, elem };
+	unsigned pos = hash & (size - 1);
+	unsigned dist = 0;
+
+	while (1) {
+		struct dh_slot *s = slots + pos;
+		if (!s->elem) {
+			*s = cur;
+			return;
+		}
+		// take the slot from an element that is closer to its home
+		unsigned sdist = dh_dist(size, s->hash, pos);
+		if (sdist < dist) {
+			struct dh_slot tmp = *s;
+			*s = cur;
+			cur = tmp;
+			dist = sdist;
+		}
+		pos = (pos + 1) & (size - 1);
+		dist++;
+	}
 }
 
 // -----------------------------------------------------------------------
-unsigned dh_hash(struct dh_table *dh, char *str)
+static int dh_grow(struct dh_table *dh)
 {
-	unsigned v = 0;
-	char *c = str;
+	unsigned size = dh->size << 1;
+
+	struct dh_slot *slots = calloc(size, sizeof(struct dh_slot));
+	if (!slots) {
+		return -1;
+	}
 
-	while (c && *c) {
-		v = (dh->case_sens ? *c : tolower(*c)) + (v<<5) - v;
-		c++;
+	for (unsigned i=0 ; i<dh->size ; i++) {
+		if (dh->slots[i].elem) {
+			dh_insert(slots, size, dh->slots[i].hash, dh->slots[i].elem);
+		}
 	}
 
-	return v % dh->size;
+	free(dh->slots);
+	dh->slots = slots;
+	dh->size = size;
+
+	return 0;
 }
 
 // -----------------------------------------------------------------------
 struct dh_elem * dh_get(struct dh_table *dh, char *name)
 {
-	unsigned hash = dh_hash(dh, name);
-	struct dh_elem *elem = dh->slots[hash];
+	unsigned hash;
+	int pos = dh_lookup(dh, name, &hash);
 
-	while (elem) {
-		if (!(dh->str_cmp(name, elem->name))) {
-			return elem;
-		}
-		elem = elem->next;
+	if (pos < 0) {
+		return NULL;
 	}
 
-	return NULL;
+	return dh->slots[pos].elem;
 }
 
 // -----------------------------------------------------------------------
 struct dh_elem * dh_add(struct dh_table *dh, char *name, int type, int value, struct st *t)
 {
-	unsigned hash = dh_hash(dh, name);
-	struct dh_elem *elem = dh->slots[hash];
+	unsigned hash;
 
-	while (elem) {
-		if (!dh->str_cmp(name, elem->name)) {
-			return NULL;
-		}
-		elem = elem->next;
+	if (dh_lookup(dh, name, &hash) >= 0) {
+		return NULL;
 	}
 
-	struct dh_elem *new_elem = malloc(sizeof(struct dh_elem));
-	new_elem->name = strdup(name);
+	if ((dh->count + 1 > DH_LOAD_MAX(dh->size)) && dh_grow(dh)) {
+		return NULL;
+	}
+
+	// name is stored just after the element
+	size_t len = strlen(name) + 1;
+	struct dh_elem *new_elem = malloc(sizeof(struct dh_elem) + len);
+	if (!new_elem) {
+		return NULL;
+	}
+	new_elem->name = memcpy(new_elem + 1, name, len);
 	new_elem->type = type;
 	new_elem->value = value;
 	new_elem->t = t;
 	new_elem->being_evaluated = 0;
-	new_elem->next = dh->slots[hash];
-	dh->slots[hash] = new_elem;
+	new_elem->locals = NULL;
+	new_elem->parent = NULL;
+
+	dh_insert(dh->slots, dh->size, hash, new_elem);
+	dh->count++;
 
 	return new_elem;
 }
@@ -107,92 +218,91 @@ struct dh_elem * dh_add(struct dh_table *dh, char *name, int type, int value, st
 // -----------------------------------------------------------------------
 int dh_delete(struct dh_table *dh, char *name)
 {
-	unsigned hash = dh_hash(dh, name);
-	struct dh_elem *prev = NULL;
-	struct dh_elem *elem = dh->slots[hash];
-
-	while (elem) {
-		if (!(dh->str_cmp(name, elem->name))) {
-			if (prev) {
-				prev->next = elem->next;
-			} else {
-				dh->slots[hash] = elem->next;
-			}
-			free(elem->name);
-			st_drop(elem->t);
-			free(elem);
-			return 0;
-		}
-		prev = elem;
-		elem = elem->next;
+	unsigned hash;
+	int pos = dh_lookup(dh, name, &hash);
+
+	if (pos < 0) {
+		return -1;
+	}
+
+	dh_destroy(dh->slots[pos].elem->locals);
+	free(dh->slots[pos].elem);
+	dh->count--;
+
+	// shift following elements back, until an empty slot
+	// or an element in its home slot is found
+	unsigned next = (pos + 1) & (dh->size - 1);
+	while (dh->slots[next].elem && dh_dist(dh->size, dh->slots[next].hash, next)) {
+		dh->slots[pos] = dh->slots[next];
+		pos = next;
+		next = (next + 1) & (dh->size - 1);
 	}
-	return -1;
+	dh->slots[pos].elem = NULL;
+
+	return 0;
 }
 
 // -----------------------------------------------------------------------
-void dh_destroy(struct dh_table *dh)
+// Remove all elements. Table keeps its size.
+void dh_clear(struct dh_table *dh)
 {
-	int i;
-	struct dh_elem *elem;
-	struct dh_elem *tmp;
-
 	if (!dh) return;
 
-	for(i=0 ; i<dh->size ; i++) {
-		elem = dh->slots[i];
-		while (elem) {
-			tmp = elem->next;
-			free(elem->name);
-			if (elem->t) st_drop(elem->t);
-			free(elem);
-			elem = tmp;
+	for (unsigned i=0 ; i<dh->size ; i++) {
+		if (dh->slots[i].elem) {
+			dh_destroy(dh->slots[i].elem->locals);
+			free(dh->slots[i].elem);
 		}
 	}
+	memset(dh->slots, 0, dh->size * sizeof(struct dh_slot));
+	dh->count = 0;
+}
 
+// -----------------------------------------------------------------------
+void dh_destroy(struct dh_table *dh)
+{
+	if (!dh) return;
+
+	dh_clear(dh);
 	free(dh->slots);
 	free(dh);
 }
 
 // -----------------------------------------------------------------------
-void dh_dump_stats(struct dh_table *dh)
+void dh_dump_stats(struct dh_table *dh, FILE *f)
 {
-	int i;
-	int elem_total = 0, collisions = 0, max_depth = 0;
-
-	struct dh_elem *elem;
+	unsigned max_probe = 0;
+	unsigned long probe_total = 0;
 
 	if (!dh) return;
 
-	unsigned *elem_slot = calloc(dh->size, sizeof(int));
-
-	for(i=0 ; i<dh->size ; i++) {
-		elem = dh->slots[i];
-		int depth = 0;
-		while (elem) {
-			depth++;
-			elem_total++;
-			elem_slot[i]++;
-			if (elem_slot[i] > 1) {
-				collisions++;
-			}
-			elem = elem->next;
+	// number of probes needed to find each element
+	unsigned *probes = calloc(dh->size + 1, sizeof(unsigned));
+	if (!probes) return;
+
+	for (unsigned i=0 ; i<dh->size ; i++) {
+		if (dh->slots[i].elem) {
+			unsigned p = dh_dist(dh->size, dh->slots[i].hash, i) + 1;
+			probes[p]++;
+			probe_total += p;
+			if (p > max_probe) max_probe = p;
 		}
-		if (depth > max_depth) max_depth = depth;
-	}
-
-	fprintf(stderr, "-----------------------------------\n");
-	fprintf(stderr, "      Slots: %d\n", dh->size);
-	fprintf(stderr, "   Elements: %d\n", elem_total);
-	fprintf(stderr, "  Max depth: %d\n", max_depth);
-	fprintf(stderr, " Collisions: %d\n", collisions);
-	fprintf(stderr, "   Collided: \n");
-	for(i=0 ; i<dh->size ; i++) {
-		if (elem_slot[i] > 1) {
-			fprintf(stderr, " %10d: %d\n", i, elem_slot[i]-1);
+	}
+
+	fprintf(f, "-----------------------------------\n");
+	fprintf(f, "      Slots: %u\n", dh->size);
+	fprintf(f, "   Elements: %u\n", dh->count);
+	fprintf(f, "       Load: %.2f\n", (double) dh->count / dh->size);
+	fprintf(f, "  Max probe: %u\n", max_probe);
+	fprintf(f, "  Avg probe: %.2f\n", dh->count ? (double) probe_total / dh->count : 0.0);
+	fprintf(f, "     Probes:\n");
+	for (unsigned i=1 ; i<=max_probe ; i++) {
+		if (probes[i]) {
+			fprintf(f, " %10u: %u\n", i, probes[i]);
 		}
 	}
 
-	free(elem_slot);
+	free(probes);
 }
 
 // vim: tabstop=4 autoindent
@@ -18,24 +18,38 @@
 #ifndef DH_H
 #define DH_H
 
-#include "st.h"
+#include <stdio.h>
 
-typedef int (*str_cmp_fun)(const char *s1, const char *s2);
+#include "st.h"
 
 struct dh_elem {
 	char *name;
 	int type;
 	int value;
-	struct st *t;
-	struct dh_elem *next;
+	struct st *t;		// not owned by the table
 	int being_evaluated;
+	struct dh_table *locals;	// names local to this one (owned by the element)
+	struct dh_elem *parent;	// atoms of local names: symbol table entry of their label
+};
+
+// Get the element of a name stored in a table (names are kept just after elements)
+#define dh_elem_of(name) ((struct dh_elem *) (name) - 1)
+
+// Elements are allocated separately, so pointers to them stay valid
+// when the table grows. Slots only keep the element hash and pointer.
+struct dh_slot {
+	unsigned hash;
+	struct dh_elem *elem;	// NULL = empty slot
 };
 
+// Open addressing table with Robin Hood hashing (linear probing,
+// elements far from their home slot take over the closer ones)
 struct dh_table {
-	int size;
-	struct dh_elem **slots;
+	unsigned size;		// number of slots (power of 2)
+	unsigned count;		// number of elements
 	int case_sens;
-	str_cmp_fun str_cmp;
+	int key_offset;		// names are hashed and compared from this offset on
+	struct dh_slot *slots;
 };
 
 struct dh_table * dh_create(int size, int case_sens);
@@ -44,8 +58,9 @@ struct dh_elem * dh_add(struct dh_table *dh, char *name, int type, int value, st
 #define dh_addv(dh, name, type, value) dh_add(dh, name, type, value, NULL)
 #define dh_addt(dh, name, type, t) dh_add(dh, name, type, 0, t)
 int dh_delete(struct dh_table *dh, char *name);
+void dh_clear(struct dh_table *dh);
 void dh_destroy(struct dh_table *dh);
-void dh_dump_stats(struct dh_table *dh);
+void dh_dump_stats(struct dh_table *dh, FILE *f);
 
 #endif
 
@@ -20,77 +20,276 @@
 #include <string.h>
 #include <getopt.h>
 
-#include "keywords.h"
-#include "parser.h"
-#include "prog.h"
-#include "lexer_utils.h"
-#include "writers.h"
-
-enum output_types {
-	O_DEBUG	= 1,
-	O_RAW	= 2,
-	O_KEYS	= 4,
-};
-
-int yyparse();
-int yylex_destroy();
-extern FILE *yyin;
+#include "libemas.h"
+#include "batch.h"
+#ifdef WITH_SERVER
+#include "server.h"
+#endif
 
 char *input_file;
 char *output_file;
 char *basename;
 int otype = O_RAW;
+int main_out;
+int typed_outs;
+struct emas_opts opts;
+
+int batch_mode;
+int batch_jobs = 1;
+char **batch_inputs;
+
+char *serve_socket;
+char *client_socket;
+int client_forced;
+
+int print_stats;
+
+struct emas_variant *variants;
+int variant_count;
 
 // -----------------------------------------------------------------------
 void usage()
 {
 	fprintf(stderr, "Usage: emas [options] [input]\n");
+	fprintf(stderr, "       emas [options] --batch [-j <n>] <input|@list> ...\n");
 	fprintf(stderr, "Where options are one or more of:\n");
 	fprintf(stderr, "   -o <output>    : set output file\n");
+	fprintf(stderr, "   -m <map>       : also write the symbol map to <map>\n");
+	fprintf(stderr, "   -g <lines>     : also write the address to source line table to <lines>\n");
 	fprintf(stderr, "   -c <cpu>       : set CPU type: mera400, mx16\n");
-	fprintf(stderr, "   -O <otype>     : set output type: raw, debug, keys (defaults to raw)\n");
+	fprintf(stderr, "   -O <otype>     : set output type: raw, seg, debug, keys, listing, map,\n");
+	fprintf(stderr, "                    lines, obj (defaults to raw)\n");
+	fprintf(stderr, "   -O <otype>=<f> : also write <otype> output to file <f>. May be repeated,\n");
+	fprintf(stderr, "                    there is no main output if only those are given\n");
 	fprintf(stderr, "   -I <dir>       : search for include files in <dir>\n");
 	fprintf(stderr, "   -D <const>[=v] : define a constant and optionaly set its value (0 by default)\n");
+	fprintf(stderr, "   -V <name>:<opts>: assemble variant <name>, <opts> is a comma-separated list of\n");
+	fprintf(stderr, "                    -D <const>[=v] and -c <cpu> options. May be repeated, all variants\n");
+	fprintf(stderr, "                    are assembled from a single parse into <output>.<name> files\n");
 	fprintf(stderr, "   -d             : print debug information to stderr (lots of)\n");
+	fprintf(stderr, "   --batch        : assemble all given sources, outputs are named after inputs\n");
+	fprintf(stderr, "                    (@list reads \"source [output]\" lines from a file)\n");
+	fprintf(stderr, "   -j <n>         : use <n> worker threads (1 by default), in batch mode to assemble\n");
+	fprintf(stderr, "                    sources, otherwise to encode the program\n");
+#ifdef WITH_SERVER
+	fprintf(stderr, "   --serve <sock> : run as an assembler server listening on unix socket <sock>\n");
+	fprintf(stderr, "   --client[=sock]: have the server do the work (socket defaults to $EMAS_SOCKET)\n");
+	fprintf(stderr, "                    (when $EMAS_SOCKET is set, server is used if available)\n");
+#endif
+	fprintf(stderr, "   --stats        : print memory usage and symbol table statistics to stderr\n");
 	fprintf(stderr, "   -v             : print version and exit\n");
 	fprintf(stderr, "   -h             : print help and exit\n");
 }
 
 // -----------------------------------------------------------------------
-int parse_args(int argc, char **argv)
+// Add a variant given as "name:opt,opt,...", where each option
+// is either -D<const>[=v] or -c<cpu>
+int variant_add(char *spec)
 {
-	char *strval;
-	int val = 0;
+	char *opt, *next;
+	char *colon = strchr(spec, ':');
+	int len = colon ? colon-spec : strlen(spec);
+
+	if (len == 0) {
+		fprintf(stderr, "Missing variant name: '%s'.\n", spec);
+		return -1;
+	}
+
+	struct emas_variant *v = realloc(variants, (variant_count+1) * sizeof(struct emas_variant));
+	if (!v) {
+		return -1;
+	}
+	variants = v;
+	v += variant_count;
+	variant_count++;
+	memset(v, 0, sizeof(struct emas_variant));
+	v->name = strdup(spec);
+	v->name[len] = '\0';
+
+	if (!colon) {
+		return 0;
+	}
+
+	char *list = strdup(colon+1);
+	for (opt=list ; opt ; opt=next) {
+		next = strchr(opt, ',');
+		if (next) {
+			*next++ = '\0';
+		}
+		while (*opt == ' ') opt++;
+		char *arg = (opt[0] && opt[1]) ? opt+2 : "";
+		while (*arg == ' ') arg++;
+		if (!strncmp(opt, "-D", 2) && *arg) {
+			emas_list_add(&v->defs, arg);
+		} else if (!strncmp(opt, "-c", 2) && *arg) {
+			v->cpu = cpu_by_name(arg);
+			if (v->cpu == CPU_DEFAULT) {
+				fprintf(stderr, "Unknown cpu in variant '%s': '%s'.\n", v->name, arg);
+				free(list);
+				return -1;
+			}
+		} else {
+			fprintf(stderr, "Unknown option in variant '%s': '%s'.\n", v->name, opt);
+			free(list);
+			return -1;
+		}
+	}
+	free(list);
 
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+int otype_by_name(char *name, int len)
+{
+	static struct { char *name; int type; } otypes[] = {
+		{ "raw", O_RAW },
+		{ "debug", O_DEBUG },
+		{ "keys", O_KEYS },
+		{ "obj", O_OBJ },
+		{ "listing", O_LISTING },
+		{ "map", O_MAP },
+		{ "lines", O_LINES },
+		{ "seg", O_SEG },
+		{ NULL, 0 }
+	};
+
+	for (int i=0 ; otypes[i].name ; i++) {
+		if ((strlen(otypes[i].name) == len) && !strncmp(otypes[i].name, name, len)) {
+			return otypes[i].type;
+		}
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Add an output written from the same assembly
+int output_add(int type, char *name)
+{
+	struct emas_out *outs = realloc(opts.outs, (opts.out_count+1) * sizeof(struct emas_out));
+	if (!outs) {
+		fprintf(stderr, "Cannot allocate memory for output '%s'.\n", name);
+		return -1;
+	}
+	opts.outs = outs;
+	outs += opts.out_count++;
+	outs->type = type;
+	outs->name = name;
+	outs->f = NULL;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Output given as "type" sets the main output type,
+// "type=file" adds an output on top of it
+int output_parse(char *spec)
+{
+	char *eq = strchr(spec, '=');
+	int len = eq ? eq-spec : strlen(spec);
+	int type = otype_by_name(spec, len);
+
+	if (!type) {
+		fprintf(stderr, "Unknown output type: '%.*s'.\n", len, spec);
+		return -1;
+	}
+
+	if (!eq) {
+		otype = type;
+		main_out = 1;
+		return 0;
+	}
+
+	if (!eq[1]) {
+		fprintf(stderr, "Missing output file name: '%s'.\n", spec);
+		return -1;
+	}
+
+	typed_outs++;
+
+	return output_add(type, eq+1);
+}
+
+// -----------------------------------------------------------------------
+// Make sure no file is written twice (or over the input)
+int outputs_check()
+{
+	for (int i=0 ; i<opts.out_count ; i++) {
+		char *name = opts.outs[i].name;
+		if (!strcmp(name, "-")) continue;
+		int dup = (output_file && !strcmp(name, output_file)) || (input_file && !strcmp(name, input_file));
+		for (int j=0 ; j<i ; j++) {
+			dup |= !strcmp(name, opts.outs[j].name);
+		}
+		if (dup) {
+			fprintf(stderr, "Output file name used more than once: '%s'\n", name);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+int parse_args(int argc, char **argv)
+{
 	int option;
-	while ((option = getopt(argc, argv,"I:D:c:O:vhdo:")) != -1) {
+	static struct option long_opts[] = {
+		{ "batch", no_argument, NULL, 'b' },
+		{ "stats", no_argument, NULL, 's' },
+#ifdef WITH_SERVER
+		{ "serve", required_argument, NULL, 'S' },
+		{ "client", optional_argument, NULL, 'C' },
+#endif
+		{ NULL, 0, NULL, 0 }
+	};
+
+	while ((option = getopt_long(argc, argv,"I:D:c:O:V:vhdo:m:g:j:", long_opts, NULL)) != -1) {
 		switch (option) {
+			case 'b':
+				batch_mode = 1;
+				break;
+			case 's':
+				print_stats = 1;
+				opts.sym_stats = 1;
+				break;
+			case 'S':
+				serve_socket = optarg;
+				break;
+			case 'C':
+				client_forced = 1;
+				if (optarg) {
+					client_socket = optarg;
+				}
+				break;
+			case 'j':
+				batch_jobs = atoi(optarg);
+				if (batch_jobs < 1) {
+					fprintf(stderr, "Wrong number of jobs: '%s'.\n", optarg);
+					return -1;
+				}
+				break;
 			case 'c':
-				if (prog_cpu(optarg, CPU_FORCED)) {
+				opts.cpu = cpu_by_name(optarg);
+				if (opts.cpu == CPU_DEFAULT) {
 					fprintf(stderr, "Unknown cpu: '%s'.\n", optarg);
 					return -1;
 				}
 				break;
 			case 'I':
-				inc_path_add(optarg);
+				emas_list_add(&opts.inc_paths, optarg);
 				break;
 			case 'D':
-				strval = strchr(optarg, '=');
-				if (strval) {
-					*strval = '\0';
-					val = atoi(strval+1);
+				emas_list_add(&opts.defs, optarg);
+				break;
+			case 'V':
+				if (variant_add(optarg)) {
+					return -1;
 				}
-				add_const(optarg, val);
 				break;
 			case 'O':
-				if (!strcmp(optarg, "raw")) {
-					otype = O_RAW;
-				} else if (!strcmp(optarg, "debug")) {
-					otype = O_DEBUG;
-				} else if (!strcmp(optarg, "keys")) {
-					otype = O_KEYS;
-				} else {
-					fprintf(stderr, "Unknown output type: '%s'.\n", optarg);
+				if (output_parse(optarg)) {
 					return -1;
 				}
 				break;
@@ -103,17 +302,66 @@ int parse_args(int argc, char **argv)
 				exit(0);
 				break;
 			case 'd':
-				aadebug = 1;
+				opts.debug = 1;
 				break;
 			case 'o':
 				output_file = strdup(optarg);
+				main_out = 1;
+				break;
+			case 'm':
+				if (output_add(O_MAP, optarg)) {
+					return -1;
+				}
+				break;
+			case 'g':
+				if (output_add(O_LINES, optarg)) {
+					return -1;
+				}
 				break;
 			default:
 				return -1;
 		}
 	}
 
-	if (optind == argc) {
+#ifdef WITH_SERVER
+	if (!client_socket) {
+		client_socket = getenv("EMAS_SOCKET");
+	}
+	if (client_forced && !client_socket) {
+		fprintf(stderr, "No server socket given for client mode.\n");
+		return -1;
+	}
+	if (serve_socket) {
+		return 0;
+	}
+#endif
+
+	if (variant_count && (batch_mode || client_forced)) {
+		fprintf(stderr, "Variants cannot be used in batch or client mode.\n");
+		return -1;
+	}
+
+	if (opts.out_count && (variant_count || batch_mode || client_forced)) {
+		fprintf(stderr, "Several outputs can only be written for a single source assembled locally.\n");
+		return -1;
+	}
+
+	// single source is encoded in parallel, batch jobs run in parallel instead
+	if (!batch_mode) {
+		opts.jobs = batch_jobs;
+	}
+
+	if (batch_mode) {
+		if (output_file) {
+			fprintf(stderr, "Output file cannot be set in batch mode.\n");
+			return -1;
+		}
+		if (optind == argc) {
+			fprintf(stderr, "No input files given for batch mode.\n");
+			return -1;
+		}
+		batch_inputs = argv + optind;
+	} else if (optind == argc) {
 		input_file = NULL;
 	} else if (optind == argc-1) {
 		input_file = argv[optind];
@@ -126,86 +374,113 @@ int parse_args(int argc, char **argv)
 }
 
 // -----------------------------------------------------------------------
-int main(int argc, char **argv)
+int run_batch()
 {
-	int ret = 1;
-	int res;
-	FILE *outf = NULL;
+	int failed;
+	char **i;
 
-	if (kw_init() < 0) {
-		fprintf(stderr, "Internal dictionary initialization failed.\n");
-		goto cleanup;
+	struct batch *b = batch_create();
+	if (!b) {
+		fprintf(stderr, "Failed to create batch.\n");
+		return 1;
 	}
 
-	sym = dh_create(16000, 1);
-	if (!sym) {
-		fprintf(stderr, "Failed to create symbol table.\n");
-		goto cleanup;
+	for (i=batch_inputs ; *i ; i++) {
+		if (**i == '@') {
+			if (batch_add_list(b, *i+1)) {
+				batch_destroy(b);
+				return 1;
+			}
+		} else if (batch_add(b, *i, NULL)) {
+			fprintf(stderr, "Failed to add '%s' to batch.\n", *i);
+			batch_destroy(b);
+			return 1;
+		}
 	}
 
-	res = parse_args(argc, argv);
+	failed = batch_run(b, &opts, otype, batch_jobs);
+	batch_destroy(b);
 
-	if (res) {
-		fprintf(stderr, "\n");
-		usage();
-		goto cleanup;
-	}
+	return failed ? 1 : 0;
+}
 
-	if (input_file) {
-		yyin = fopen(input_file, "r");
-		loc_push(input_file);
-	} else {
-		yyin = stdin;
-		loc_push("(stdin)");
+// -----------------------------------------------------------------------
+// Assemble all variants from a single parse. Outputs are named after
+// the variant, unless they go to stdout.
+int run_variants(struct emas_ctx *ctx, struct emas_out *out)
+{
+	int i;
+
+	for (i=0 ; i<variant_count ; i++) {
+		struct emas_variant *v = variants + i;
+		v->out = *out;
+		if (!out->f && strcmp(out->name, "-")) {
+			v->out.name = malloc(strlen(out->name) + strlen(v->name) + 2);
+			if (!v->out.name) {
+				return 1;
+			}
+			sprintf(v->out.name, "%s.%s", out->name, v->name);
+		}
 	}
 
-	if (!yyin) {
-		fprintf(stderr, "Cannot open source file: '%s'\n", input_file);
-		goto cleanup;
-	}
+	return emas_assemble_variants(ctx, input_file, &opts, variants, variant_count) ? 1 : 0;
+}
 
-	inc_path_add(".");
-	inc_path_add(EMAS_ASM_INCLUDES);
-	inc_path_add("/usr/share/emas/include");
-	inc_path_add("/usr/local/share/emas/include");
+// -----------------------------------------------------------------------
+void variants_free()
+{
+	int i;
 
-	AADEBUG("==== Include search dirs ==================");
-	struct st *i = inc_paths;
-	while (i) {
-		AADEBUG("%s", i->str);
-		i = i->next;
+	for (i=0 ; i<variant_count ; i++) {
+		if (variants[i].out.name != output_file) {
+			free(variants[i].out.name);
+		}
+		free(variants[i].name);
+		emas_list_free(variants[i].defs);
 	}
+	free(variants);
+}
 
-	AADEBUG("==== Parse ================================");
-	if (yyparse()) {
-		if (yyin) fclose(yyin);
+// -----------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+	int ret = 1;
+	int res;
+	struct emas_ctx *ctx = NULL;
+	struct emas_out out = { 0, NULL, NULL };
+
+	if (emas_init() < 0) {
+		fprintf(stderr, "Internal dictionary initialization failed.\n");
 		goto cleanup;
 	}
 
-	if (yyin) fclose(yyin);
+	res = parse_args(argc, argv);
 
-	if (!program) { // shouldn't happen - parser should always produce a program (even an empty one)
-		fprintf(stderr, "Parse produced empty tree.\n");
+	if (res) {
+		fprintf(stderr, "\n");
+		usage();
 		goto cleanup;
 	}
 
-	res = assemble(program, 1);
+#ifdef WITH_SERVER
+	if (serve_socket) {
+		ret = server_run(serve_socket);
+		goto cleanup;
+	}
+#endif
 
-	if (res < 0) {
-		fprintf(stderr, "%s\n", aerr);
+	if (batch_mode) {
+		ret = run_batch();
 		goto cleanup;
-	} else if (res > 0) {
-		if (assemble(program, 0)) {
-			fprintf(stderr, "%s\n", aerr);
-			goto cleanup;
-		}
 	}
 
 	// set the output file name if no given
-	if (!output_file) {
-		if ((otype == O_DEBUG) || (otype == O_KEYS)) {
+	// (there is no main output if only "-O type=file" ones are given,
+	// -m and -g outputs go next to the main one)
+	if (!output_file && (main_out || !typed_outs)) {
+		if ((otype == O_DEBUG) || (otype == O_KEYS) || (otype == O_LISTING)) {
 			output_file = strdup("(stdout)");
-			outf = stdout;
+			out.f = stdout;
 		} else {
 			if (!input_file) {
 				output_file = strdup("a.out");
@@ -218,6 +493,18 @@ int main(int argc, char **argv)
 
 				if (otype == O_RAW) {
 					output_file = strdup(basename);
+				} else if (otype == O_OBJ) {
+					output_file = malloc(strlen(basename) + 3);
+					sprintf(output_file, "%s.o", basename);
+				} else if (otype == O_SEG) {
+					output_file = malloc(strlen(basename) + 5);
+					sprintf(output_file, "%s.seg", basename);
+				} else if (otype == O_MAP) {
+					output_file = malloc(strlen(basename) + 5);
+					sprintf(output_file, "%s.map", basename);
+				} else if (otype == O_LINES) {
+					output_file = malloc(strlen(basename) + 7);
+					sprintf(output_file, "%s.lines", basename);
 				} else {
 					fprintf(stderr, "Unknown output file type.");
 					goto cleanup;
@@ -232,53 +519,62 @@ int main(int argc, char **argv)
 		}
 	}
 
-	if (outf != stdout) {
-		if ((otype == O_RAW) && !strcmp(output_file, "-")) {
-			outf = stdout;
-		} else {
-			outf = fopen(output_file, "wb");
-			if (!outf) {
-				fprintf(stderr, "Cannot open output file '%s' for writing\n", output_file);
-				goto cleanup;
-			}
-		}
+	if (outputs_check()) {
+		goto cleanup;
 	}
 
-	switch (otype) {
-		case O_RAW:
-			res = writer_raw(program, outf);
-			break;
-		case O_DEBUG:
-			res = writer_debug(program, outf);
-			break;
-		case O_KEYS:
-			res = writer_keys(program, outf);
-			break;
-		default:
-			fprintf(stderr, "Unknown output type.\n");
-			fclose(outf);
+	out.type = otype;
+	out.name = output_file;
+
+	ctx = emas_create();
+	if (!ctx) {
+		fprintf(stderr, "Failed to create assembler context.\n");
+		goto cleanup;
+	}
+
+#ifdef WITH_SERVER
+	if (client_socket && !variant_count && !opts.out_count) {
+		res = client_assemble(client_socket, input_file, &opts, &out);
+		if ((res < 0) && client_forced) {
+			fprintf(stderr, "Cannot connect to the assembler server at '%s'.\n", client_socket);
+			goto cleanup;
+		} else if (res >= 0) {
+			ret = res ? 1 : 0;
 			goto cleanup;
+		}
+		// no server running, assemble locally
 	}
+#endif
 
-	fclose(outf);
+	if (variant_count) {
+		res = run_variants(ctx, &out);
+	} else {
+		res = emas_assemble(ctx, input_file, &opts, output_file ? &out : NULL);
+	}
+
+	if (print_stats) {
+		struct emas_stats stats;
+		emas_get_stats(ctx, &stats);
+		fprintf(stderr, "Syntax tree memory: %zu bytes reserved, %zu used\n", stats.arena_bytes, stats.arena_used);
+		fprintf(stderr, "Syntax tree nodes: %zu created, %zu reused, %zu peak\n", stats.nodes_total, stats.nodes_reused, stats.nodes_peak);
+	}
 
 	if (res) {
-		fprintf(stderr, "%s\n", aerr);
 		goto cleanup;
 	}
+
 	ret = 0;
 
 cleanup:
 
-	yylex_destroy();
-	st_drop(inc_paths);
-	st_drop(filenames);
-	st_drop(program);
-	dh_destroy(sym);
-	st_drop(entry);
-	kw_destroy();
+	emas_destroy(ctx);
+	emas_shutdown();
+	emas_list_free(opts.inc_paths);
+	emas_list_free(opts.defs);
+	variants_free();
 	free(output_file);
 	free(basename);
+	free(opts.outs);
 
 	return ret;
 }
@@ -0,0 +1,417 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <getopt.h>
+
+#include "libemas.h"
+#include "obj.h"
+#include "dh.h"
+
+// Module being linked. Object file is kept in memory as read,
+// words are decoded from it when needed.
+struct module {
+	char *name;
+	uint8_t *buf;
+	uint32_t words;		// file size in words
+	int cpu;
+	uint32_t base;		// module location in the linked program
+	uint32_t size;
+	uint32_t chunk_count;
+	uint32_t sym_count;
+	uint32_t reloc_count;
+	uint32_t chunks;	// positions (in words) of the file sections
+	uint32_t syms;
+	uint32_t relocs;
+	int *values;		// final symbol values, by symbol index (-1 = unresolved)
+};
+
+char *output_file;
+struct module *modules;
+int module_count;
+struct dh_table *exports;
+
+// -----------------------------------------------------------------------
+void usage()
+{
+	fprintf(stderr, "Usage: emld [options] <object> ...\n");
+	fprintf(stderr, "Links relocatable modules (produced with emas -O obj) into a raw program image.\n");
+	fprintf(stderr, "Modules are placed in memory one after another, in the order given.\n");
+	fprintf(stderr, "Where options are one or more of:\n");
+	fprintf(stderr, "   -o <output>    : set output file (a.out by default)\n");
+	fprintf(stderr, "   -v             : print version and exit\n");
+	fprintf(stderr, "   -h             : print help and exit\n");
+}
+
+// -----------------------------------------------------------------------
+static uint16_t word(struct module *m, uint32_t pos)
+{
+	return (m->buf[2*pos] << 8) | m->buf[2*pos+1];
+}
+
+// -----------------------------------------------------------------------
+static uint32_t dword(struct module *m, uint32_t pos)
+{
+	return ((uint32_t) word(m, pos) << 16) | word(m, pos+1);
+}
+
+// -----------------------------------------------------------------------
+// Get a symbol name (it needs to be freed)
+static char * sym_name(struct module *m, uint32_t pos)
+{
+	int len = word(m, pos+2);
+	char *name = malloc(len+1);
+	if (name) {
+		memcpy(name, m->buf + 2*(pos+3), len);
+		name[len] = '\0';
+	}
+
+	return name;
+}
+
+// -----------------------------------------------------------------------
+// Find a symbol by index (symbols differ in size, they need to be walked over)
+static uint32_t sym_pos(struct module *m, uint32_t index)
+{
+	uint32_t pos = m->syms;
+
+	for (uint32_t i=0 ; i<index ; i++) {
+		pos += 3 + (word(m, pos+2) + 1) / 2;
+	}
+
+	return pos;
+}
+
+// -----------------------------------------------------------------------
+static uint8_t * file_read(char *name, uint32_t *words)
+{
+	FILE *f = fopen(name, "rb");
+	if (!f) {
+		fprintf(stderr, "Cannot open object file: '%s'\n", name);
+		return NULL;
+	}
+
+	fseek(f, 0, SEEK_END);
+	long len = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	uint8_t *buf = malloc(len > 0 ? len : 1);
+	if (!buf || (fread(buf, 1, len, f) != (size_t) len)) {
+		fprintf(stderr, "Cannot read object file: '%s'\n", name);
+		free(buf);
+		fclose(f);
+		return NULL;
+	}
+	fclose(f);
+
+	*words = len / 2;
+
+	return buf;
+}
+
+// -----------------------------------------------------------------------
+// Read the object file and find where its sections are
+static int module_load(struct module *m, char *name)
+{
+	uint32_t pos;
+
+	m->name = name;
+	m->buf = file_read(name, &m->words);
+	if (!m->buf) {
+		return -1;
+	}
+
+	if ((m->words < OBJ_HEADER_WORDS) || (word(m, 0) != OBJ_MAGIC_HI) || (word(m, 1) != OBJ_MAGIC_LO)) {
+		fprintf(stderr, "%s: Not an object file\n", name);
+		return -1;
+	}
+	if (word(m, 2) != OBJ_VERSION) {
+		fprintf(stderr, "%s: Unsupported object file version: %i\n", name, word(m, 2));
+		return -1;
+	}
+
+	m->cpu = word(m, 3);
+	m->size = dword(m, 4);
+	m->chunk_count = dword(m, 6);
+	m->sym_count = dword(m, 8);
+	m->reloc_count = dword(m, 10);
+
+	pos = m->chunks = OBJ_HEADER_WORDS;
+	for (uint32_t i=0 ; i<m->chunk_count ; i++) {
+		if ((pos + 6 > m->words) || ((uint64_t) dword(m, pos) + dword(m, pos+2) > m->size)) goto broken;
+		if (!(word(m, pos+4) & OBJ_CHUNK_FILL)) {
+			pos += dword(m, pos+2);
+		}
+		pos += 6;
+	}
+
+	m->syms = pos;
+	for (uint32_t i=0 ; i<m->sym_count ; i++) {
+		if (pos + 3 > m->words) goto broken;
+		pos += 3 + (word(m, pos+2) + 1) / 2;
+	}
+
+	m->relocs = pos;
+	if ((pos > m->words) || ((uint64_t) m->reloc_count * 6 > m->words - pos)) goto broken;
+
+	m->values = malloc((m->sym_count ? m->sym_count : 1) * sizeof(int));
+	if (!m->values) {
+		fprintf(stderr, "%s: Cannot allocate memory for the symbol table\n", name);
+		return -1;
+	}
+
+	return 0;
+
+broken:
+	fprintf(stderr, "%s: Object file is broken\n", name);
+	return -1;
+}
+
+// -----------------------------------------------------------------------
+// Add symbols exported by the module to the global symbol table
+static int module_export(struct module *m)
+{
+	uint32_t pos = m->syms;
+
+	for (uint32_t i=0 ; i<m->sym_count ; i++) {
+		int flags = word(m, pos);
+		if (flags & OBJ_SYM_EXPORT) {
+			int value = word(m, pos+1);
+			if (flags & OBJ_SYM_RELATIVE) {
+				value = (value + m->base) & 0xffff;
+			}
+			char *name = sym_name(m, pos);
+			if (!name) {
+				fprintf(stderr, "%s: Cannot allocate memory for the symbol table\n", m->name);
+				return -1;
+			}
+			struct dh_elem *s = dh_get(exports, name);
+			if (s) {
+				fprintf(stderr, "%s: Symbol '%s' already defined in %s\n", m->name, name, modules[s->type].name);
+				free(name);
+				return -1;
+			}
+			// (element type holds the module the symbol comes from)
+			s = dh_addv(exports, name, m - modules, value);
+			free(name);
+			if (!s) {
+				fprintf(stderr, "%s: Cannot allocate memory for the symbol table\n", m->name);
+				return -1;
+			}
+		}
+		pos += 3 + (word(m, pos+2) + 1) / 2;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Get final values of all the symbols module uses (each name is looked up once)
+static int module_import(struct module *m)
+{
+	uint32_t pos = m->syms;
+
+	for (uint32_t i=0 ; i<m->sym_count ; i++) {
+		char *name = sym_name(m, pos);
+		if (!name) {
+			fprintf(stderr, "%s: Cannot allocate memory for the symbol table\n", m->name);
+			return -1;
+		}
+		struct dh_elem *s = dh_get(exports, name);
+		m->values[i] = s ? s->value : -1;
+		free(name);
+		pos += 3 + (word(m, pos+2) + 1) / 2;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Copy module sections into the program image and relocate it
+static int module_link(struct module *m, uint8_t *image)
+{
+	uint32_t pos = m->chunks;
+
+	for (uint32_t i=0 ; i<m->chunk_count ; i++) {
+		uint32_t addr = m->base + dword(m, pos);
+		uint32_t len = dword(m, pos+2);
+		if (word(m, pos+4) & OBJ_CHUNK_FILL) {
+			uint16_t fill = word(m, pos+5);
+			for (uint32_t w=0 ; w<len ; w++) {
+				image[2*(addr+w)] = fill >> 8;
+				image[2*(addr+w)+1] = fill;
+			}
+			pos += 6;
+		} else {
+			// both are big-endian, the chunk is copied as it is
+			memcpy(image + 2*addr, m->buf + 2*(pos+6), 2*len);
+			pos += 6 + len;
+		}
+	}
+
+	pos = m->relocs;
+	for (uint32_t i=0 ; i<m->reloc_count ; i++, pos+=6) {
+		uint32_t addr = dword(m, pos);
+		uint32_t sym = dword(m, pos+2);
+		int32_t addend = dword(m, pos+4);
+		int value;
+		if (addr >= m->size) {
+			fprintf(stderr, "%s: Relocation outside the module at 0x%04x\n", m->name, addr);
+			return -1;
+		}
+		if (sym == OBJ_SYM_SECTION) {
+			value = m->base;
+		} else if (sym < m->sym_count) {
+			value = m->values[sym];
+			if (value < 0) {
+				char *name = sym_name(m, sym_pos(m, sym));
+				fprintf(stderr, "%s: Undefined symbol '%s'\n", m->name, name ? name : "?");
+				free(name);
+				return -1;
+			}
+		} else {
+			fprintf(stderr, "%s: Relocation refers to a symbol that does not exist: %u\n", m->name, sym);
+			return -1;
+		}
+		uint16_t w = value + addend;
+		image[2*(m->base+addr)] = w >> 8;
+		image[2*(m->base+addr)+1] = w;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int link_modules(char *output)
+{
+	uint32_t end = 0;
+	uint32_t max = 65536;
+	int ret = 1;
+	uint8_t *image = NULL;
+	FILE *f = NULL;
+
+	for (int i=0 ; i<module_count ; i++) {
+		struct module *m = modules + i;
+		if (!(m->cpu & CPU_MX16)) {
+			max = 32768;
+		}
+		m->base = end;
+		end += m->size;
+	}
+
+	if (end > max) {
+		fprintf(stderr, "Program too large (>%i words)\n", max);
+		return 1;
+	}
+
+	exports = dh_create(256, 1);
+	if (!exports) {
+		fprintf(stderr, "Failed to create symbol table.\n");
+		return 1;
+	}
+
+	for (int i=0 ; i<module_count ; i++) {
+		if (module_export(modules+i)) goto cleanup;
+	}
+
+	image = calloc(end ? end : 1, 2);
+	if (!image) {
+		fprintf(stderr, "Cannot allocate memory for the program image\n");
+		goto cleanup;
+	}
+
+	for (int i=0 ; i<module_count ; i++) {
+		if (module_import(modules+i) || module_link(modules+i, image)) goto cleanup;
+	}
+
+	f = fopen(output, "wb");
+	if (!f) {
+		fprintf(stderr, "Cannot open output file '%s' for writing\n", output);
+		goto cleanup;
+	}
+	if (fwrite(image, 2, end, f) != end) {
+		fprintf(stderr, "Write failed\n");
+		goto cleanup;
+	}
+
+	ret = 0;
+
+cleanup:
+	if (f) fclose(f);
+	free(image);
+	dh_destroy(exports);
+
+	return ret;
+}
+
+// -----------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+	int option;
+	int ret = 1;
+
+	while ((option = getopt(argc, argv, "o:vh")) != -1) {
+		switch (option) {
+			case 'o':
+				output_file = optarg;
+				break;
+			case 'v':
+				fprintf(stderr, "EMLD v%s - linker for EMAS relocatable modules\n", EMAS_VERSION);
+				return 0;
+			case 'h':
+				usage();
+				return 0;
+			default:
+				usage();
+				return 1;
+		}
+	}
+
+	if (optind >= argc) {
+		fprintf(stderr, "No object files given.\n\n");
+		usage();
+		return 1;
+	}
+
+	module_count = argc - optind;
+	modules = calloc(module_count, sizeof(struct module));
+	if (!modules) {
+		fprintf(stderr, "Cannot allocate memory for modules\n");
+		return 1;
+	}
+
+	for (int i=0 ; i<module_count ; i++) {
+		if (module_load(modules+i, argv[optind+i])) goto cleanup;
+	}
+
+	ret = link_modules(output_file ? output_file : "a.out");
+
+cleanup:
+	for (int i=0 ; i<module_count ; i++) {
+		free(modules[i].buf);
+		free(modules[i].values);
+	}
+	free(modules);
+
+	return ret;
+}
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,216 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "st.h"
+#include "prog.h"
+#include "expr.h"
+#include "encode.h"
+#include "ctx.h"
+
+// Part of the statement array encoded by a single worker
+struct encode_chunk {
+	struct emas_ctx *ctx;
+	int from;
+	int to;
+	int err;			// first statement that failed (-1 if none)
+	char aerr[MAX_ERRLEN+1];
+	struct arena arena;	// allocations made by the worker
+	struct expr_state expr;
+	pthread_t thread;
+};
+
+// -----------------------------------------------------------------------
+// Check if the statement is left for the encoding phase. Size of such
+// statement is known up front and it doesn't change anything but itself.
+int encode_deferred(struct st *t)
+{
+	switch (t->type) {
+		case N_WORD:
+		case N_DWORD:
+		case N_FLOAT:
+		case N_OP_RT:
+		case N_OP_T:
+		case N_OP_SHC:
+		case N_OP_BLC:
+		case N_OP_BRC:
+		case N_OP_EXL:
+		case N_OP_NRF:
+		case N_OP_HLT:
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+// -----------------------------------------------------------------------
+int encode_size(struct st *t)
+{
+	switch (t->type) {
+		case N_WORD:
+		case N_DWORD:
+		case N_FLOAT:
+			return t->size; // known since the data run was parsed
+		default:
+			return 1;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Encode statements of a chunk using a private copy of the context.
+// Symbol definitions are shared, so they are only read here: statements
+// referring to symbols that are not evaluated yet are left for later.
+static void * encode_worker(void *ptr)
+{
+	struct encode_chunk *c = ptr;
+	struct emas_ctx *w = malloc(sizeof(struct emas_ctx));
+
+	c->err = -1;
+	arena_init(&c->arena, sizeof(struct st));
+	memset(&c->expr, 0, sizeof(struct expr_state));
+
+	if (!w) { // statements are left for the serial pass
+		return NULL;
+	}
+
+	*w = *c->ctx;
+	w->arena = c->arena;
+	w->expr = c->expr;
+	w->sym_readonly = 1;
+	w->aerr[0] = '\0';
+
+	for (int i=c->from ; i<c->to ; i++) {
+		struct st *t = w->stmts[i];
+		if (!encode_deferred(t)) continue;
+		w->ic = t->ic;
+		w->unresolved = NULL;
+		if (eval(w, t) < 0) {
+			c->err = i;
+			strcpy(c->aerr, w->aerr);
+			break;
+		}
+	}
+
+	c->arena = w->arena;
+	c->expr = w->expr;
+	free(w);
+
+	return NULL;
+}
+
+// -----------------------------------------------------------------------
+// Encode deferred statements in parallel chunks. Returns index of the first
+// statement that failed with an error (its message goes to aerr)
+// or 'to' if there was none. Statements before the returned index that
+// workers didn't encode are left for the serial pass.
+static int encode_parallel(struct emas_ctx *ctx, int from, int to, int workers, char *aerr)
+{
+	int end = to;
+	int started = 0;
+	int per_chunk = (to - from + workers - 1) / workers;
+
+	struct encode_chunk *chunks = calloc(workers, sizeof(struct encode_chunk));
+	if (!chunks) { // do it all in the serial pass
+		return to;
+	}
+
+	for (int i=0 ; i<workers ; i++) {
+		chunks[i].ctx = ctx;
+		chunks[i].from = from + i * per_chunk;
+		chunks[i].to = chunks[i].from + per_chunk < to ? chunks[i].from + per_chunk : to;
+	}
+
+	// first chunk is encoded by the calling thread
+	for (int i=1 ; i<workers ; i++) {
+		if (pthread_create(&chunks[i].thread, NULL, encode_worker, chunks+i)) {
+			break;
+		}
+		started++;
+	}
+
+	encode_worker(chunks);
+
+	for (int i=1 ; i<=started ; i++) {
+		pthread_join(chunks[i].thread, NULL);
+	}
+
+	// chunks that didn't get a thread come last, the serial pass
+	// encodes them (errors found by workers are all before them)
+	for (int i=0 ; i<=started ; i++) {
+		if ((chunks[i].err >= 0) && (chunks[i].err < end)) {
+			end = chunks[i].err;
+			strcpy(aerr, chunks[i].aerr);
+		}
+		arena_merge(&ctx->arena, &chunks[i].arena);
+		expr_free(&chunks[i].expr);
+	}
+
+	free(chunks);
+
+	return end;
+}
+
+// -----------------------------------------------------------------------
+// Encode deferred statements from the given range of the statement array.
+// Statements that cannot be encoded yet (because of undefined symbols)
+// are left as they are. Errors are reported for the first failing statement
+// in program order, no matter how the work was split.
+int encode(struct emas_ctx *ctx, int from, int to)
+{
+	int end = to;
+	int workers = ctx->jobs;
+	char aerr[MAX_ERRLEN+1];
+
+	if (ctx->aadebug) { // keep debug output in order
+		workers = 1;
+	}
+	if (workers > (to - from) / ENCODE_CHUNK_MIN) {
+		workers = (to - from) / ENCODE_CHUNK_MIN;
+	}
+
+	if (workers > 1) {
+		end = encode_parallel(ctx, from, to, workers, aerr);
+	}
+
+	// statements left over by workers (and all of them, if there were no workers)
+	// (encoding may be done in the middle of the layout, which needs its IC back)
+	int ic = ctx->ic;
+	for (int i=from ; i<end ; i++) {
+		struct st *t = ctx->stmts[i];
+		if (!encode_deferred(t)) continue;
+		ctx->ic = t->ic;
+		ctx->unresolved = NULL;
+		if (eval(ctx, t) < 0) {
+			ctx->ic = ic;
+			return -1;
+		}
+	}
+	ctx->ic = ic;
+
+	if (end < to) {
+		strcpy(ctx->aerr, aerr);
+		return -1;
+	}
+
+	return 0;
+}
+
+// vim: tabstop=4 autoindent
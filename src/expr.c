@@ -0,0 +1,591 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "dh.h"
+#include "st.h"
+#include "prog.h"
+#include "expr.h"
+#include "ctx.h"
+
+#define IS_OPERATOR(type) (((type) >= N_PLUS) && ((type) <= N_NEG))
+
+// -----------------------------------------------------------------------
+// Make sure there is room for 'need' elements in the buffer
+static int expr_grow(void **buf, int *cap, int need, size_t size)
+{
+	if (need <= *cap) {
+		return 0;
+	}
+
+	int c = *cap ? *cap : 64;
+	while (c < need) {
+		c *= 2;
+	}
+
+	void *b = realloc(*buf, c * size);
+	if (!b) {
+		return -1;
+	}
+
+	*buf = b;
+	*cap = c;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+void expr_free(struct expr_state *e)
+{
+	free(e->work);
+	free(e->out);
+	free(e->stack);
+	free(e->frames);
+	for (int i=0 ; i<e->leaf_count ; i++) {
+		free(e->leaves[i]);
+	}
+	free(e->leaves);
+}
+
+// -----------------------------------------------------------------------
+// Set up a bytecode instruction for the node
+static void expr_bc_set(struct emas_ctx *ctx, struct bc *c, struct st *n)
+{
+	c->op = n->type;
+	c->flags = n->flags;
+	c->t = n;
+	switch (n->type) {
+		case N_INT:
+			c->val = n->val;
+			break;
+		case N_FLO:
+			c->flo = n->flo;
+			break;
+		case N_CURLOC:
+			// location is known when the expression is first evaluated
+			c->op = N_INT;
+			c->flags = ST_RELATIVE;
+			c->val = ctx->ic;
+			break;
+		case N_NAME:
+			if (!n->sym) { // node created after the binding pass
+				n->sym = sym_ref(ctx, n->str);
+			}
+			c->sym = n->sym;
+			break;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Compile expression tree into bytecode (without recursion)
+static struct bc * expr_compile(struct emas_ctx *ctx, struct st *t)
+{
+	struct expr_state *e = &ctx->expr;
+	int wsp = 0;
+	int count = 0;
+
+	// nodes come out in reversed postfix order: node, last arg, ..., first arg
+	if (expr_grow((void**) &e->work, &e->work_cap, 1, sizeof(struct st*))) goto nomem;
+	e->work[wsp++] = t;
+	while (wsp) {
+		struct st *n = e->work[--wsp];
+		if ((n->type != N_INT) && (n->type != N_FLO) && (n->type != N_NAME) && (n->type != N_CURLOC) && !IS_OPERATOR(n->type)) {
+			aaerror(ctx, n, "Cannot eval node type %i", n->type);
+			return NULL;
+		}
+		if (expr_grow((void**) &e->out, &e->out_cap, count+1, sizeof(struct st*))) goto nomem;
+		e->out[count++] = n;
+		if (IS_OPERATOR(n->type)) {
+			for (struct st *arg=n->args ; arg ; arg=arg->next) {
+				if (expr_grow((void**) &e->work, &e->work_cap, wsp+1, sizeof(struct st*))) goto nomem;
+				e->work[wsp++] = arg;
+			}
+		}
+	}
+
+	struct bc *code = arena_alloc(&ctx->arena, (count+1) * sizeof(struct bc));
+	if (!code) goto nomem;
+
+	struct bc *c = code;
+	while (count > 0) {
+		expr_bc_set(ctx, c, e->out[--count]);
+		c++;
+	}
+	c->op = N_NONE;
+
+	return code;
+
+nomem:
+	aaerror(ctx, t, "Cannot allocate memory for expression evaluation");
+	return NULL;
+}
+
+// -----------------------------------------------------------------------
+// Get bytecode for a one-node expression evaluated at the given frame depth.
+// Such code is not worth keeping, so it goes to a buffer reused by all
+// expressions evaluated at that depth.
+static struct bc * expr_leaf(struct emas_ctx *ctx, struct st *t, int depth)
+{
+	struct expr_state *e = &ctx->expr;
+
+	if ((t->type != N_INT) && (t->type != N_FLO) && (t->type != N_NAME) && (t->type != N_CURLOC)) {
+		aaerror(ctx, t, "Cannot eval node type %i", t->type);
+		return NULL;
+	}
+
+	while (e->leaf_count <= depth) {
+		if (expr_grow((void**) &e->leaves, &e->leaves_cap, e->leaf_count+1, sizeof(struct bc*))) goto nomem;
+		e->leaves[e->leaf_count] = malloc(2 * sizeof(struct bc));
+		if (!e->leaves[e->leaf_count]) goto nomem;
+		e->leaf_count++;
+	}
+
+	struct bc *code = e->leaves[depth];
+	expr_bc_set(ctx, code, t);
+	code[1].op = N_NONE;
+
+	return code;
+
+nomem:
+	aaerror(ctx, t, "Cannot allocate memory for expression evaluation");
+	return NULL;
+}
+
+// -----------------------------------------------------------------------
+// Get bytecode for an expression. Code for operators is kept in the node,
+// so expressions retried during fixup resolution are compiled only once.
+static struct bc * expr_code(struct emas_ctx *ctx, struct st *t, int depth)
+{
+	if (!IS_OPERATOR(t->type)) {
+		return expr_leaf(ctx, t, depth);
+	}
+
+	if (!t->code) {
+		t->code = expr_compile(ctx, t);
+	}
+
+	return t->code;
+}
+
+// -----------------------------------------------------------------------
+static void val2float(struct bc_val *v)
+{
+	if (v->type == N_INT) {
+		double flo = v->val;
+		v->type = N_FLO;
+		v->flo = flo;
+	}
+}
+
+// -----------------------------------------------------------------------
+static int expr_1arg_int(struct emas_ctx *ctx, struct st *t, struct bc_val *arg)
+{
+	int64_t val = arg->val;
+
+	switch (t->type) {
+		case N_UMINUS:
+			arg->val = -val;
+			break;
+		case N_NEG:
+			arg->val = ~val;
+			break;
+		default:
+			assert(!"unknown 1-arg operator node");
+			return -1;
+	}
+
+	AADEBUG(ctx, "%s %lli = %lli", eval_tab[t->type].name, (long long) val, (long long) arg->val);
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int expr_1arg_float(struct emas_ctx *ctx, struct st *t, struct bc_val *arg)
+{
+	double flo = arg->flo;
+
+	switch (t->type) {
+		case N_UMINUS:
+			arg->flo = -flo;
+			break;
+		default:
+			aaerror(ctx, t, "Illegal operator for float number: %s", eval_tab[t->type].name);
+			return -1;
+	}
+
+	AADEBUG(ctx, "%s %f = %f", eval_tab[t->type].name, flo, arg->flo);
+
+	arg->flags = 0;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int expr_2arg_int(struct emas_ctx *ctx, struct st *t, struct bc_val *arg1, struct bc_val *arg2)
+{
+	int64_t val;
+
+	switch (t->type) {
+		case N_PLUS:
+			val = arg1->val + arg2->val;
+			break;
+		case N_MINUS:
+			val = arg1->val - arg2->val;
+			break;
+		case N_MUL:
+			val = arg1->val * arg2->val;
+			break;
+		case N_DIV:
+			if (arg2->val == 0) {
+				aaerror(ctx, t, "Division by 0");
+				return -1;
+			}
+			val = arg1->val / arg2->val;
+			break;
+		case N_REM:
+			if (arg2->val == 0) {
+				aaerror(ctx, t, "Division by 0");
+				return -1;
+			}
+			val = arg1->val % arg2->val;
+			break;
+		case N_AND:
+			val = arg1->val & arg2->val;
+			break;
+		case N_XOR:
+			val = arg1->val ^ arg2->val;
+			break;
+		case N_OR:
+			val = arg1->val | arg2->val;
+			break;
+		case N_LSHIFT:
+			val = arg1->val << arg2->val;
+			break;
+		case N_RSHIFT:
+			val = arg1->val >> arg2->val;
+			break;
+		case N_SCALE:
+			val = arg1->val << (15-arg2->val);
+			break;
+		default:
+			assert(!"unknown 2-arg operator");
+			return -1;
+	}
+
+	AADEBUG(ctx, "%lli %s %lli = %lli", (long long) arg1->val, eval_tab[t->type].name, (long long) arg2->val, (long long) val);
+
+	arg1->val = val;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int expr_2arg_float(struct emas_ctx *ctx, struct st *t, struct bc_val *arg1, struct bc_val *arg2)
+{
+	double flo;
+
+	switch (t->type) {
+		case N_PLUS:
+			flo = arg1->flo + arg2->flo;
+			break;
+		case N_MINUS:
+			flo = arg1->flo - arg2->flo;
+			break;
+		case N_MUL:
+			flo = arg1->flo * arg2->flo;
+			break;
+		case N_DIV:
+			if (arg2->flo == 0.0) {
+				aaerror(ctx, t, "Division by 0");
+				return -1;
+			}
+			flo = arg1->flo / arg2->flo;
+			break;
+		default:
+			aaerror(ctx, t, "Illegal operator for float numbers: %s", eval_tab[t->type].name);
+			return -1;
+	}
+
+	AADEBUG(ctx, "%f %s %f = %f", arg1->flo, eval_tab[t->type].name, arg2->flo, flo);
+
+	arg1->flo = flo;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// In a relocatable module, relative values are kept in a canonical
+// base+addend form, where base is the module itself (ST_RELATIVE) or an
+// external symbol (ST_EXTERN). Only operations that preserve the form
+// are allowed: base+const, const+base, base-const and base-base (with the
+// same base, the result is absolute). arg2 is NULL for 1-arg operators.
+static int expr_reloc(struct emas_ctx *ctx, struct st *t, struct bc_val *arg1, struct bc_val *arg2)
+{
+	int base1 = arg1->flags & (ST_RELATIVE | ST_EXTERN);
+	int base2 = arg2 ? arg2->flags & (ST_RELATIVE | ST_EXTERN) : 0;
+
+	if (!base1 && !base2) {
+		return 0;
+	}
+
+	if ((arg1->type == N_FLO) || (arg2 && (arg2->type == N_FLO))) {
+		// no float may be relocated
+	} else if ((t->type == N_PLUS) && arg2 && !(base1 && base2)) {
+		if (base2) {
+			arg1->flags = arg2->flags;
+			arg1->ext = arg2->ext;
+		}
+		return 0;
+	} else if ((t->type == N_MINUS) && !base2) {
+		return 0;
+	} else if ((t->type == N_MINUS) && (base1 == base2) && ((base1 == ST_RELATIVE) || (arg1->ext == arg2->ext))) {
+		arg1->flags = 0;
+		return 0;
+	}
+
+	aaerror(ctx, t, "Expression cannot be relocated");
+	return -1;
+}
+
+// -----------------------------------------------------------------------
+// Apply an operator to values on top of the stack, leave the result there
+static int expr_op(struct emas_ctx *ctx, struct st *t, struct bc_val *top)
+{
+	if (t->type == N_UMINUS || t->type == N_NEG) {
+		struct bc_val *arg = top;
+		if (arg->type == N_NONE) {
+			return 0;
+		} else if (ctx->relocatable && expr_reloc(ctx, t, arg, NULL)) {
+			return -1;
+		} else if (arg->type == N_INT) {
+			return expr_1arg_int(ctx, t, arg);
+		} else {
+			return expr_1arg_float(ctx, t, arg);
+		}
+	}
+
+	struct bc_val *arg1 = top - 1;
+	struct bc_val *arg2 = top;
+
+	if ((arg1->type == N_NONE) || (arg2->type == N_NONE)) {
+		arg1->type = N_NONE;
+		return 0;
+	}
+
+	if (ctx->relocatable) {
+		if (expr_reloc(ctx, t, arg1, arg2)) {
+			return -1;
+		}
+	} else if ((t->type == N_MINUS) && (arg1->flags & ST_RELATIVE) && (arg2->flags & ST_RELATIVE)) {
+		// relative - relative = absolute
+		arg1->flags = 0;
+	} else {
+		arg1->flags = (arg1->flags | arg2->flags) & ST_RELATIVE;
+	}
+
+	if ((arg1->type == N_INT) && (arg2->type == N_INT)) {
+		return expr_2arg_int(ctx, t, arg1, arg2);
+	} else {
+		val2float(arg1);
+		val2float(arg2);
+		return expr_2arg_float(ctx, t, arg1, arg2);
+	}
+}
+
+// -----------------------------------------------------------------------
+// Store evaluated value in the node (it becomes a constant)
+static void expr_store(struct emas_ctx *ctx, struct st *t, struct bc_val *v)
+{
+	t->type = v->type;
+	if (v->type == N_FLO) {
+		t->flo = v->flo;
+	} else {
+		t->val = v->val;
+	}
+	t->flags |= v->flags & (ST_RELATIVE | ST_EXTERN);
+	st_drop(ctx, t->args);
+	if (v->flags & ST_EXTERN) {
+		t->ext = v->ext;
+	}
+	t->args = t->last = NULL;
+}
+
+// -----------------------------------------------------------------------
+// Fold value of a variable into the instruction that referred to it.
+// Variables may be redefined later on, and expressions retried during
+// fixup resolution need to see the value they had when first evaluated.
+static void expr_fold_var(struct bc *pc, struct dh_elem *s, struct bc_val *v)
+{
+	if ((s->type & SYM_CONST) || (v->type == N_NONE) || (v->flags & ST_EXTERN)) {
+		return;
+	}
+
+	pc->op = v->type;
+	pc->flags = v->flags;
+	if (v->type == N_FLO) {
+		pc->flo = v->flo;
+	} else {
+		pc->val = v->val;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Evaluate an expression. Symbol definitions are evaluated on the way
+// (using an explicit frame stack, not recursion) and replaced with their
+// values. Evaluation continues past unresolved symbols, so errors
+// are reported the same way no matter the order of arguments.
+int eval_expr(struct emas_ctx *ctx, struct st *t)
+{
+	struct expr_state *e = &ctx->expr;
+	struct bc *pc;
+	struct dh_elem *s;
+	int sp = 0;
+	int fp = 0;
+	int u = 0;
+
+	pc = expr_code(ctx, t, 0);
+	if (!pc) return -1;
+
+	while (1) {
+		if (expr_grow((void**) &e->stack, &e->stack_cap, sp+1, sizeof(struct bc_val))) {
+			aaerror(ctx, pc->t, "Cannot allocate memory for expression evaluation");
+			u = -1;
+			break;
+		}
+		struct bc_val *v = e->stack + sp;
+
+		switch (pc->op) {
+			case N_NONE:
+				if (fp == 0) {
+					goto done;
+				}
+				// symbol definition evaluated, keep its value
+				fp--;
+				s = e->frames[fp].s;
+				s->being_evaluated--;
+				if (e->stack[sp-1].type != N_NONE) {
+					expr_store(ctx, s->t, e->stack + sp - 1);
+				}
+				pc = e->frames[fp].ret;
+				expr_fold_var(pc, s, e->stack + sp - 1);
+				pc++;
+				continue;
+			case N_INT:
+				v->type = N_INT;
+				v->flags = pc->flags & ST_RELATIVE;
+				v->val = pc->val;
+				sp++;
+				break;
+			case N_FLO:
+				v->type = N_FLO;
+				v->flags = pc->flags & ST_RELATIVE;
+				v->flo = pc->flo;
+				sp++;
+				break;
+			case N_NAME:
+				s = pc->sym;
+				if (s && (s->type & SYM_UNDEFINED) && (s->type & SYM_GLOBAL) && ctx->externs) {
+					// defined in another module, the linker fills it in
+					v->type = N_INT;
+					v->flags = ST_EXTERN;
+					v->val = 0;
+					v->ext = s;
+					sp++;
+					break;
+				}
+				if (!s || (s->type & SYM_UNDEFINED)) {
+					ctx->unresolved = s;
+					aaerror(ctx, pc->t, "Symbol '%s' not defined", pc->t->str);
+					v->type = N_NONE;
+					sp++;
+					break;
+				}
+				assert(s->t);
+				if ((s->t->type == N_INT) || (s->t->type == N_FLO)) {
+					v->type = s->t->type;
+					v->flags = s->t->flags & (ST_RELATIVE | ST_EXTERN);
+					if (v->type == N_FLO) {
+						v->flo = s->t->flo;
+					} else {
+						v->val = s->t->val;
+					}
+					if (v->flags & ST_EXTERN) {
+						v->ext = s->t->ext;
+					}
+					expr_fold_var(pc, s, v);
+					sp++;
+					break;
+				}
+				if (ctx->sym_readonly) { // leave the evaluation to the owner
+					v->type = N_NONE;
+					sp++;
+					break;
+				}
+				if (s->being_evaluated > 0) {
+					aaerror(ctx, pc->t, "Symbol '%s' is defined recursively", pc->t->str);
+					v->type = N_NONE;
+					sp++;
+					break;
+				}
+				// evaluate symbol definition first
+				struct bc *code = expr_code(ctx, s->t, fp+1);
+				if (!code || expr_grow((void**) &e->frames, &e->frames_cap, fp+1, sizeof(struct bc_frame))) {
+					u = -1;
+					goto fail;
+				}
+				e->frames[fp].ret = pc;
+				e->frames[fp].s = s;
+				fp++;
+				s->being_evaluated++;
+				pc = code;
+				continue;
+			default:
+				if (expr_op(ctx, pc->t, v - 1)) {
+					u = -1;
+					goto fail;
+				}
+				if ((pc->op != N_UMINUS) && (pc->op != N_NEG)) { // 2 args -> 1 result
+					sp--;
+				}
+				break;
+		}
+		pc++;
+	}
+
+fail:
+	while (fp > 0) {
+		e->frames[--fp].s->being_evaluated--;
+	}
+	return u;
+
+done:
+	assert(sp == 1);
+	if (e->stack->type == N_NONE) {
+		return 1;
+	}
+	if (t->type != N_INT && t->type != N_FLO) {
+		expr_store(ctx, t, e->stack);
+	}
+
+	return 0;
+}
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,82 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef EXPR_H
+#define EXPR_H
+
+#include <inttypes.h>
+
+struct emas_ctx;
+struct dh_elem;
+struct st;
+
+// Expression bytecode instruction. Expressions are compiled to postfix
+// order, instructions are node types:
+//  * N_INT, N_FLO: push a constant (current location is compiled in as one)
+//  * N_NAME: push symbol value (evaluate symbol definition first, if needed)
+//  * operators: pop arguments, push the result
+//  * N_NONE: end of code
+struct bc {
+	int16_t op;
+	uint16_t flags;		// constant flags
+	union {
+		int64_t val;	// integer constant
+		double flo;		// float constant
+		struct dh_elem *sym;	// symbol
+	};
+	struct st *t;		// source node (for diagnostics)
+};
+
+// Value on the evaluation stack
+struct bc_val {
+	int16_t type;		// N_INT, N_FLO or N_NONE (unresolved)
+	uint16_t flags;
+	union {
+		int64_t val;
+		double flo;
+	};
+	struct dh_elem *ext;	// external symbol (ST_EXTERN values)
+};
+
+// Symbol evaluation in progress
+struct bc_frame {
+	struct bc *ret;		// instruction that referenced the symbol
+	struct dh_elem *s;
+};
+
+// Buffers used for compilation and evaluation (reused between runs)
+struct expr_state {
+	struct st **work;
+	int work_cap;
+	struct st **out;
+	int out_cap;
+	struct bc_val *stack;
+	int stack_cap;
+	struct bc_frame *frames;
+	int frames_cap;
+	struct bc **leaves;	// code for one-node expressions, one per frame depth
+	int leaf_count;
+	int leaves_cap;
+};
+
+int eval_expr(struct emas_ctx *ctx, struct st *t);
+void expr_free(struct expr_state *e);
+
+#endif
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,187 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fmt.h"
+
+static const char hex_digits[] = "0123456789abcdef";
+
+// bits of a nibble (shorter groups use the tail)
+static const char bin_digits[16][4] = {
+	"0000", "0001", "0010", "0011", "0100", "0101", "0110", "0111",
+	"1000", "1001", "1010", "1011", "1100", "1101", "1110", "1111",
+};
+
+// -----------------------------------------------------------------------
+struct fmt * fmt_create(FILE *f)
+{
+	struct fmt *o = malloc(sizeof(struct fmt));
+	if (!o) {
+		return NULL;
+	}
+
+	o->f = f;
+	o->err = 0;
+	o->len = 0;
+
+	return o;
+}
+
+// -----------------------------------------------------------------------
+// Flush and free the output. Returns non-zero if anything failed.
+int fmt_destroy(struct fmt *o)
+{
+	int res = fmt_flush(o);
+	free(o);
+
+	return res;
+}
+
+// -----------------------------------------------------------------------
+int fmt_flush(struct fmt *o)
+{
+	if (o->len && (fwrite(o->buf, 1, o->len, o->f) != (size_t) o->len)) {
+		o->err = 1;
+	}
+	o->len = 0;
+
+	return o->err;
+}
+
+// -----------------------------------------------------------------------
+// Make sure there is room for 'count' characters (count <= FMT_BUF_SIZE)
+static inline char * fmt_reserve(struct fmt *o, int count)
+{
+	if (o->len + count > FMT_BUF_SIZE) {
+		fmt_flush(o);
+	}
+
+	return o->buf + o->len;
+}
+
+// -----------------------------------------------------------------------
+void fmt_strn(struct fmt *o, const char *s, int len)
+{
+	while (len > 0) {
+		int n = len < FMT_BUF_SIZE ? len : FMT_BUF_SIZE;
+		memcpy(fmt_reserve(o, n), s, n);
+		o->len += n;
+		s += n;
+		len -= n;
+	}
+}
+
+// -----------------------------------------------------------------------
+void fmt_str(struct fmt *o, const char *s)
+{
+	fmt_strn(o, s, strlen(s));
+}
+
+// -----------------------------------------------------------------------
+void fmt_char(struct fmt *o, char c)
+{
+	*fmt_reserve(o, 1) = c;
+	o->len++;
+}
+
+// -----------------------------------------------------------------------
+void fmt_fill(struct fmt *o, char c, int count)
+{
+	while (count > 0) {
+		int n = count < FMT_BUF_SIZE ? count : FMT_BUF_SIZE;
+		memset(fmt_reserve(o, n), c, n);
+		o->len += n;
+		count -= n;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Hex number with exactly 'digits' digits (up to 8)
+void fmt_hex(struct fmt *o, unsigned value, int digits)
+{
+	char *b = fmt_reserve(o, digits);
+
+	for (int i=digits-1 ; i>=0 ; i--) {
+		b[i] = hex_digits[value & 15];
+		value >>= 4;
+	}
+	o->len += digits;
+}
+
+// -----------------------------------------------------------------------
+// Octal number with exactly 'digits' digits (up to 11)
+void fmt_oct(struct fmt *o, unsigned value, int digits)
+{
+	char *b = fmt_reserve(o, digits);
+
+	for (int i=digits-1 ; i>=0 ; i--) {
+		b[i] = '0' + (value & 7);
+		value >>= 3;
+	}
+	o->len += digits;
+}
+
+// -----------------------------------------------------------------------
+// Decimal number, right-aligned to at least 'width' characters (up to 20)
+void fmt_dec(struct fmt *o, int64_t value, int width)
+{
+	char tmp[24];
+	char *p = tmp + sizeof(tmp);
+	uint64_t v = value < 0 ? -(uint64_t) value : (uint64_t) value;
+
+	do {
+		*--p = '0' + v % 10;
+		v /= 10;
+	} while (v);
+	if (value < 0) {
+		*--p = '-';
+	}
+
+	int len = tmp + sizeof(tmp) - p;
+	if (len < width) {
+		fmt_fill(o, ' ', width - len);
+	}
+	memcpy(fmt_reserve(o, len), p, len);
+	o->len += len;
+}
+
+// -----------------------------------------------------------------------
+// 16-bit binary number, split into groups of bits given as a string
+// of group sizes (1-4) and separators, e.g. "4 4 4 4"
+void fmt_bin(struct fmt *o, uint16_t value, const char *groups)
+{
+	char *b = fmt_reserve(o, 2*16);
+	int shift = 16;
+
+	for (const char *g=groups ; *g ; g++) {
+		if ((*g >= '1') && (*g <= '4')) {
+			int bits = *g - '0';
+			shift -= bits;
+			memcpy(b, bin_digits[(value >> shift) & ((1 << bits) - 1)] + 4 - bits, bits);
+			b += bits;
+		} else {
+			*b++ = *g;
+		}
+	}
+	o->len = b - o->buf;
+}
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,52 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdio.h>
+#include <inttypes.h>
+
+// text is collected in a buffer this large, before it's written out
+#define FMT_BUF_SIZE (64*1024)
+
+// Buffered text output for writers. Numbers are formatted with lookup
+// tables, straight into the buffer. Write errors are remembered
+// and reported by fmt_flush().
+struct fmt {
+	FILE *f;
+	int err;
+	int len;
+	char buf[FMT_BUF_SIZE];
+};
+
+struct fmt * fmt_create(FILE *f);
+int fmt_destroy(struct fmt *o);
+int fmt_flush(struct fmt *o);
+void fmt_str(struct fmt *o, const char *s);
+void fmt_strn(struct fmt *o, const char *s, int len);
+void fmt_char(struct fmt *o, char c);
+void fmt_fill(struct fmt *o, char c, int count);
+void fmt_hex(struct fmt *o, unsigned value, int digits);
+void fmt_oct(struct fmt *o, unsigned value, int digits);
+void fmt_dec(struct fmt *o, int64_t value, int width);
+void fmt_bin(struct fmt *o, uint16_t value, const char *groups);
+
+#endif
+
+// vim: tabstop=4 autoindent
@@ -15,18 +15,51 @@
 //  Foundation, Inc.,
 //  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 
+
 #ifndef KEYWORDS_H
 #define KEYWORDS_H
 
-#include "dh.h"
+// Assembler directive or CPU instruction
+struct kw {
+	const char *name;
+	int len;
+	int type;		// token type
+	int value;		// opcode
+};
+
+// Keyword hash (case-insensitive). Also used by kwgen to build the table.
+static inline unsigned kw_hash(const char *name, int *len)
+{
+	const char *c = name;
+	unsigned v = 2166136261u; // FNV-1a
+
+	while (*c) {
+		v ^= (unsigned char) (*c | 0x20); // fold case (letters are all that matters)
+		v *= 16777619u;
+		c++;
+	}
+	*len = c - name;
+
+	return v;
+}
+
+// Get the table slot for a hash and its bucket displacement
+static inline unsigned kw_slot(unsigned hash, unsigned disp)
+{
+	hash ^= disp;
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bu;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35u;
+	hash ^= hash >> 16;
 
-#define pragma_get(name) dh_get(keywords, name);
-#define mnemo_get(name) dh_get(keywords, name);
+	return hash;
+}
 
-extern struct dh_table *keywords;
+const struct kw * kw_get(const char *name);
 
-int kw_init();
-void kw_destroy();
+#define pragma_get(name) kw_get(name)
+#define mnemo_get(name) kw_get(name)
 
 #endif
 
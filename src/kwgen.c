@@ -0,0 +1,164 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+// Keyword table generator.
+// Builds a perfect hash table (hash and displace) for all keywords
+// listed in keywords.def and writes it as C source.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#include "keywords.h"
+
+#define KW_SLOTS 256
+#define KW_BUCKETS 64
+#define KW_DISP_MAX 65535
+
+struct kwdef {
+	const char *name;
+	const char *type;
+	const char *value;
+	unsigned hash;
+	int len;
+};
+
+struct kwdef kwdefs[] = {
+#define PRAGMA(name, type) { name, #type, "0" },
+#define OP(name, type, value) { name, #type, #value },
+#include "keywords.def"
+#undef PRAGMA
+#undef OP
+};
+
+#define KW_COUNT (int) (sizeof(kwdefs) / sizeof(struct kwdef))
+
+int bucket_size[KW_BUCKETS];
+int bucket_order[KW_BUCKETS];
+unsigned disp[KW_BUCKETS];
+int slot_kw[KW_SLOTS];
+
+// -----------------------------------------------------------------------
+static int bucket_cmp(const void *a, const void *b)
+{
+	return bucket_size[*(int*)b] - bucket_size[*(int*)a];
+}
+
+// -----------------------------------------------------------------------
+// Try to place all keywords from a bucket using given displacement
+static int bucket_place(int b, unsigned d)
+{
+	int placed[KW_COUNT];
+	int count = 0;
+
+	for (int i=0 ; i<KW_COUNT ; i++) {
+		if ((kwdefs[i].hash & (KW_BUCKETS-1)) != b) continue;
+		int slot = kw_slot(kwdefs[i].hash, d) & (KW_SLOTS-1);
+		if (slot_kw[slot] >= 0) {
+			// slot taken, roll back
+			while (count > 0) {
+				slot_kw[placed[--count]] = -1;
+			}
+			return -1;
+		}
+		slot_kw[slot] = i;
+		placed[count++] = slot;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+	if (argc != 2) {
+		fprintf(stderr, "Usage: kwgen <output.h>\n");
+		return 1;
+	}
+
+	if (KW_COUNT > KW_SLOTS) {
+		fprintf(stderr, "Too many keywords (%i) for %i slots\n", KW_COUNT, KW_SLOTS);
+		return 1;
+	}
+
+	for (int i=0 ; i<KW_COUNT ; i++) {
+		kwdefs[i].hash = kw_hash(kwdefs[i].name, &kwdefs[i].len);
+		for (int j=0 ; j<i ; j++) {
+			if (!strcasecmp(kwdefs[i].name, kwdefs[j].name)) {
+				fprintf(stderr, "Duplicate keyword: %s\n", kwdefs[i].name);
+				return 1;
+			}
+		}
+		bucket_size[kwdefs[i].hash & (KW_BUCKETS-1)]++;
+	}
+
+	for (int i=0 ; i<KW_SLOTS ; i++) {
+		slot_kw[i] = -1;
+	}
+
+	// place largest buckets first, while there is plenty of free slots
+	for (int i=0 ; i<KW_BUCKETS ; i++) {
+		bucket_order[i] = i;
+	}
+	qsort(bucket_order, KW_BUCKETS, sizeof(int), bucket_cmp);
+
+	for (int i=0 ; i<KW_BUCKETS ; i++) {
+		int b = bucket_order[i];
+		unsigned d;
+		if (!bucket_size[b]) break;
+		for (d=0 ; d<=KW_DISP_MAX ; d++) {
+			if (!bucket_place(b, d)) break;
+		}
+		if (d > KW_DISP_MAX) {
+			fprintf(stderr, "Cannot build keyword table (bucket %i does not fit)\n", b);
+			return 1;
+		}
+		disp[b] = d;
+	}
+
+	FILE *f = fopen(argv[1], "w");
+	if (!f) {
+		fprintf(stderr, "Cannot open output file: %s\n", argv[1]);
+		return 1;
+	}
+
+	fprintf(f, "// Generated by kwgen from keywords.def, do not edit\n\n");
+	fprintf(f, "#define KW_SLOTS %i\n", KW_SLOTS);
+	fprintf(f, "#define KW_BUCKETS %i\n\n", KW_BUCKETS);
+
+	fprintf(f, "static const unsigned short kw_disp[KW_BUCKETS] = {");
+	for (int i=0 ; i<KW_BUCKETS ; i++) {
+		fprintf(f, "%s%u,", i % 16 ? " " : "\n\t", disp[i]);
+	}
+	fprintf(f, "\n};\n\n");
+
+	fprintf(f, "static const struct kw kw_tab[KW_SLOTS] = {\n");
+	for (int i=0 ; i<KW_SLOTS ; i++) {
+		struct kwdef *k = kwdefs + slot_kw[i];
+		if (slot_kw[i] < 0) continue;
+		fprintf(f, "\t[%i] = { \"%s\", %i, %s, %s },\n", i, k->name, k->len, k->type, k->value);
+	}
+	fprintf(f, "};\n");
+
+	fclose(f);
+
+	return 0;
+}
+
+// vim: tabstop=4 autoindent
@@ -29,25 +29,19 @@
 #include "parser.h"
 #include "lexer_utils.h"
 #include "st.h"
-
-int lexer_err_reported;
-char str_buf[STR_MAX+1];
-int str_len;
-struct st *filenames;
-struct st *inc_paths;
-char *cur_label;
-struct loc loc_stack[INCLUDE_MAX+1];
-int loc_pos;
+#include "ctx.h"
+#include "dh.h"
 
 // -----------------------------------------------------------------------
-void llerror(char *s, ...)
+void llerror(struct emas_ctx *ctx, char *s, ...)
 {
-	lexer_err_reported = 1;
+	struct loc *l = ctx->loc_stack + ctx->loc_pos;
+	ctx->lexer_err_reported = 1;
 	va_list ap;
 	va_start(ap, s);
-	fprintf(stderr, "%s:%d:%d: ", loc_stack[loc_pos].filename, loc_stack[loc_pos].oline, loc_stack[loc_pos].ocol);
-	vfprintf(stderr, s, ap);
-	fprintf(stderr, "\n");
+	fprintf(ctx->errf, "%s:%d:%d: ", l->filename, l->oline, l->ocol);
+	vfprintf(ctx->errf, s, ap);
+	fprintf(ctx->errf, "\n");
 	va_end(ap);
 }
 
@@ -169,92 +163,141 @@ void delchar(char *str, char c)
 }
 
 // -----------------------------------------------------------------------
-int lex_int(char *str, int offset, int base, int64_t *val)
+int lex_int(struct emas_ctx *ctx, char *str, int offset, int base, int64_t *val)
 {
 	delchar(str+offset, '_');
 	errno = 0;
 	*val = strtoll(str+offset, NULL, base);
 	if (errno) {
 		// can't use strerror() - tests fail with different strings on Win64
-		llerror("Integer conversion error");
+		llerror(ctx, "Integer conversion error");
 		return 0;
 	}
 	return INT;
 }
 
 // -----------------------------------------------------------------------
-int lex_float(char *str, double *val)
+int lex_float(struct emas_ctx *ctx, char *str, double *val)
 {
 	errno = 0;
 	*val = strtod(str, NULL);
 	if (errno) {
 		// can't use strerror() - tests fail with different strings on Win64
-		llerror("Float conversion error");
+		llerror(ctx, "Float conversion error");
 		return 0;
 	}
 	return FLOAT;
 }
 
 // -----------------------------------------------------------------------
-int str_append(char c)
+int str_append(struct emas_ctx *ctx, char c)
 {
-	if (str_len >= STR_MAX) {
-		llerror("string too long");
+	if (ctx->str_len >= STR_MAX) {
+		llerror(ctx, "string too long");
 		return 0;
 	}
-	str_buf[str_len++] = c;
+	ctx->str_buf[ctx->str_len++] = c;
 	return 1;
 }
 
 // -----------------------------------------------------------------------
-void loc_update(int len)
+void loc_update(struct emas_ctx *ctx, YYLTYPE *lloc, int lineno, int len)
 {
-	loc_stack[loc_pos].oline = loc_stack[loc_pos].line;
-	loc_stack[loc_pos].line = yylineno;
-	loc_stack[loc_pos].ocol = loc_stack[loc_pos].col;
-	if (loc_stack[loc_pos].oline != loc_stack[loc_pos].line) {
-		loc_stack[loc_pos].col = 1;
+	struct loc *l = ctx->loc_stack + ctx->loc_pos;
+
+	l->oline = l->line;
+	l->line = lineno;
+	l->ocol = l->col;
+	if (l->oline != l->line) {
+		l->col = 1;
 	} else {
-		loc_stack[loc_pos].col += len;
+		l->col += len;
 	}
 
-	yylloc.filename = loc_stack[loc_pos].filename;
-	yylloc.first_line = loc_stack[loc_pos].oline;
-	yylloc.last_line = loc_stack[loc_pos].line;
-	yylloc.first_column = loc_stack[loc_pos].ocol;
-	yylloc.last_column = loc_stack[loc_pos].col;
+	lloc->filename = l->filename;
+	lloc->first_line = l->oline;
+	lloc->last_line = l->line;
+	lloc->first_column = l->ocol;
+	lloc->last_column = l->col;
+
+	// nodes created by parser actions refer to this location
+	ctx->lloc = *lloc;
 }
 
 // -----------------------------------------------------------------------
-int loc_push(char *fname)
+// Intern a string: each distinct name is stored only once per assembly
+// and the same pointer is returned for every occurrence. Atoms live
+// until the context is cleaned up.
+char * atom(struct emas_ctx *ctx, char *str)
 {
-	if (loc_pos > INCLUDE_MAX) {
-		return -1;
+	struct dh_elem *e = dh_get(ctx->atoms, str);
+	if (!e) {
+		e = dh_addv(ctx->atoms, str, 0, 0);
+		if (!e) {
+			return NULL;
+		}
+	}
+
+	return e->name;
+}
+
+// -----------------------------------------------------------------------
+// Intern a local name (prefixed with the current global label)
+char * atom_local(struct emas_ctx *ctx, char *str)
+{
+	char buf[STR_MAX+1];
+	char *name = buf;
+	char *res;
+
+	int len = strlen(ctx->cur_label) + strlen(str) + 1;
+	if (len > STR_MAX+1) {
+		name = malloc(len);
+		if (!name) {
+			return NULL;
+		}
 	}
 
-	struct st *cfname = st_str(0, fname);
-	filenames = st_app(filenames, cfname);
+	sprintf(name, "%s%s", ctx->cur_label, str);
+	res = atom(ctx, name);
 
-	loc_pos++;
+	if (name != buf) {
+		free(name);
+	}
 
-	loc_stack[loc_pos].filename = cfname->str;
-	loc_stack[loc_pos].col = 1;
-	loc_stack[loc_pos].line = 1;
-	loc_stack[loc_pos].ocol = 1;
-	loc_stack[loc_pos].oline = 1;
+	return res;
+}
 
-	loc_stack[loc_pos].yylineno = yylineno;
-	yylineno = 1;
+// -----------------------------------------------------------------------
+// Line numbers are kept by the scanner separately for each input buffer,
+// so there is no need to save/restore them here.
+int loc_push(struct emas_ctx *ctx, char *fname)
+{
+	if (ctx->loc_pos > INCLUDE_MAX) {
+		return -1;
+	}
+
+	char *afname = atom(ctx, fname);
+	if (!afname) {
+		return -1;
+	}
+
+	ctx->loc_pos++;
+
+	struct loc *l = ctx->loc_stack + ctx->loc_pos;
+	l->filename = afname;
+	l->col = 1;
+	l->line = 1;
+	l->ocol = 1;
+	l->oline = 1;
 
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int loc_pop()
+int loc_pop(struct emas_ctx *ctx)
 {
-	if (loc_pos >= 0) {
-		yylineno = loc_stack[loc_pos].yylineno;
-		loc_pos--;
+	if (ctx->loc_pos >= 0) {
+		ctx->loc_pos--;
 		return 0;
 	} else {
 		return -1;
@@ -262,32 +305,34 @@ int loc_pop()
 }
 
 // -----------------------------------------------------------------------
-int loc_file(char *fname)
+int loc_file(struct emas_ctx *ctx, char *fname)
 {
-	struct st *cfname = st_str(0, fname);
-	filenames = st_app(filenames, cfname);
-	loc_stack[loc_pos].filename = cfname->str;
+	char *afname = atom(ctx, fname);
+	if (!afname) {
+		return -1;
+	}
+	ctx->loc_stack[ctx->loc_pos].filename = afname;
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int inc_path_add(char *path)
+int inc_path_add(struct emas_ctx *ctx, char *path)
 {
-	struct st *incpath = st_str(0, path);
-	inc_paths = st_app(inc_paths, incpath);
+	struct st *incpath = st_str(ctx, 0, path);
+	ctx->inc_paths = st_app(ctx->inc_paths, incpath);
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-FILE * inc_open(char *filename)
+FILE * inc_open(struct emas_ctx *ctx, char *filename)
 {
-	struct st *path = inc_paths;
+	struct st *path = ctx->inc_paths;
 	char pbuf[STR_MAX+1];
 
 	while (path) {
 		int i = snprintf(pbuf, STR_MAX, "%s/%s", path->str, filename);
 		if (i > 0) {
-			FILE *f = fopen(pbuf, "r");
+			FILE *f = ctx->inc_open ? ctx->inc_open(pbuf, ctx->inc_open_data) : fopen(pbuf, "r");
 			if (f) {
 				return f;
 			}
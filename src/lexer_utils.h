@@ -21,41 +21,38 @@
 #include <stdio.h>
 #include <inttypes.h>
 
-extern int yylineno;
-
 #define STR_MAX 1024
 #define INCLUDE_MAX 32
 
-#define YY_USER_ACTION loc_update(yyleng);
+#define YY_USER_ACTION loc_update(yyextra, yylloc, yylineno, yyleng);
+
+struct emas_ctx;
+struct YYLTYPE;
 
 struct loc {
 	char *filename;
 	int line, col;
 	int oline, ocol;
-	int yylineno;
 };
 
-extern struct loc loc_stack[INCLUDE_MAX+1];
-extern int loc_pos;
-extern struct st *filenames;
-extern struct st *inc_paths;
-extern char *cur_label;
-
-extern char str_buf[STR_MAX+1];
-extern int str_len;
+int yylex_init_extra(struct emas_ctx *ctx, void **scanner);
+int yylex_destroy(void *scanner);
+void yyset_in(FILE *in, void *scanner);
 
-void llerror(char *s, ...);
+void llerror(struct emas_ctx *ctx, char *s, ...);
 int unesc_char(char *c, int *esclen);
 int flag2mask(char c);
-int lex_int(char *str, int offset, int base, int64_t *val);
-int lex_float(char *str, double *val);
-int str_append(char c);
-void loc_update(int len);
-int loc_push(char *fname);
-int loc_pop();
-int loc_file(char *fname);
-int inc_path_add(char *path);
-FILE * inc_open(char *filename);
+int lex_int(struct emas_ctx *ctx, char *str, int offset, int base, int64_t *val);
+int lex_float(struct emas_ctx *ctx, char *str, double *val);
+int str_append(struct emas_ctx *ctx, char c);
+void loc_update(struct emas_ctx *ctx, struct YYLTYPE *lloc, int lineno, int len);
+char * atom(struct emas_ctx *ctx, char *str);
+char * atom_local(struct emas_ctx *ctx, char *str);
+int loc_push(struct emas_ctx *ctx, char *fname);
+int loc_pop(struct emas_ctx *ctx);
+int loc_file(struct emas_ctx *ctx, char *fname);
+int inc_path_add(struct emas_ctx *ctx, char *path);
+FILE * inc_open(struct emas_ctx *ctx, char *filename);
 
 #endif
 
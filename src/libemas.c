@@ -0,0 +1,621 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "libemas.h"
+#include "ctx.h"
+#include "parser.h"
+#include "prog.h"
+#include "lexer_utils.h"
+#include "writers.h"
+
+// -----------------------------------------------------------------------
+// Initialize data shared by all contexts. Call once, before any
+// assembly is started. (There is nothing to set up since the keyword
+// table is static, but callers should not depend on that.)
+int emas_init()
+{
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+void emas_shutdown()
+{
+}
+
+// -----------------------------------------------------------------------
+struct emas_ctx * emas_create()
+{
+	struct emas_ctx *ctx = calloc(1, sizeof(struct emas_ctx));
+	if (!ctx) {
+		return NULL;
+	}
+
+	ctx->errf = stderr;
+	arena_init(&ctx->arena, sizeof(struct st));
+
+	return ctx;
+}
+
+// -----------------------------------------------------------------------
+// Drop everything that is left after an assembly run
+static void ctx_cleanup(struct emas_ctx *ctx)
+{
+	if (ctx->scanner) {
+		yylex_destroy(ctx->scanner);
+		ctx->scanner = NULL;
+	}
+	// all nodes go away with the arena
+	ctx->inc_paths = NULL;
+	ctx->program = NULL;
+	ctx->entry = NULL;
+	// symbol and atom tables are kept for the next run
+	dh_clear(ctx->sym);
+	dh_clear(ctx->atoms);
+	ctx->stmt_count = 0;
+	ctx->fixup_count = 0;
+	ctx->unresolved = NULL;
+	ctx->cur_label = NULL;
+	ctx->source = NULL;
+	arena_release(&ctx->arena);
+	st_loc_reset(ctx);
+}
+
+// -----------------------------------------------------------------------
+void emas_destroy(struct emas_ctx *ctx)
+{
+	if (!ctx) return;
+
+	ctx_cleanup(ctx);
+	dh_destroy(ctx->sym);
+	dh_destroy(ctx->atoms);
+	free(ctx->locs);
+	free(ctx->stmts);
+	free(ctx->fixups);
+	expr_free(&ctx->expr);
+	free(ctx);
+}
+
+// -----------------------------------------------------------------------
+// Resolve path relative to the context working directory (if set).
+// Returned string needs to be freed.
+char * ctx_path(struct emas_ctx *ctx, char *path)
+{
+	if (!ctx->cwd || (*path == '/')) {
+		return strdup(path);
+	}
+
+	char *p = malloc(strlen(ctx->cwd) + strlen(path) + 2);
+	if (p) {
+		sprintf(p, "%s/%s", ctx->cwd, path);
+	}
+
+	return p;
+}
+
+// -----------------------------------------------------------------------
+// Add "name[=value]" constants to the symbol table
+static void defs_add(struct emas_ctx *ctx, char **defs)
+{
+	char **s;
+
+	for (s=defs ; s && *s ; s++) {
+		char *name = strdup(*s);
+		int val = 0;
+		char *strval = strchr(name, '=');
+		if (strval) {
+			*strval = '\0';
+			val = atoi(strval+1);
+		}
+		char *a = atom(ctx, name);
+		if (a) {
+			add_const(ctx, a, val);
+		}
+		free(name);
+	}
+}
+
+// -----------------------------------------------------------------------
+static int ctx_setup(struct emas_ctx *ctx, struct emas_opts *opts)
+{
+	char **s;
+
+	ctx->errf = opts->errf ? opts->errf : stderr;
+	ctx->aadebug = opts->debug;
+	ctx->sym_stats = opts->sym_stats;
+	ctx->jobs = opts->jobs > 0 ? opts->jobs : 1;
+	ctx->cwd = opts->cwd;
+	ctx->inc_open = opts->inc_open;
+	ctx->inc_open_data = opts->inc_open_data;
+	ctx->outs = opts->outs;
+	ctx->out_count = opts->out_count;
+	ctx->aerr[0] = '\0';
+	ctx->lexer_err_reported = 0;
+	ctx->loc_pos = 0;
+	memset(&ctx->lloc, 0, sizeof(ctx->lloc));
+	ctx->ic = 0;
+	ctx->ic_max = 32767;
+	ctx->cpu = CPU_DEFAULT;
+	arena_init(&ctx->arena, sizeof(struct st));
+
+	if (opts->cpu != CPU_DEFAULT) {
+		if (prog_cpu(ctx, opts->cpu, CPU_FORCED)) {
+			fprintf(ctx->errf, "Unknown cpu type: %i.\n", opts->cpu);
+			return -1;
+		}
+	}
+
+	if (!ctx->sym) {
+		ctx->sym = dh_create(64, 1);
+	}
+	if (!ctx->sym) {
+		fprintf(ctx->errf, "Failed to create symbol table.\n");
+		return -1;
+	}
+
+	if (!ctx->atoms) {
+		ctx->atoms = dh_create(64, 1);
+	}
+	if (!ctx->atoms) {
+		fprintf(ctx->errf, "Failed to create name table.\n");
+		return -1;
+	}
+
+	defs_add(ctx, opts->defs);
+
+	for (s=opts->inc_paths ; s && *s ; s++) {
+		char *path = ctx_path(ctx, *s);
+		inc_path_add(ctx, path ? path : *s);
+		free(path);
+	}
+	inc_path_add(ctx, ctx->cwd ? ctx->cwd : ".");
+	inc_path_add(ctx, EMAS_ASM_INCLUDES);
+	inc_path_add(ctx, "/usr/share/emas/include");
+	inc_path_add(ctx, "/usr/local/share/emas/include");
+
+	if (yylex_init_extra(ctx, &ctx->scanner)) {
+		fprintf(ctx->errf, "Failed to initialize the lexer.\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Write a single output, error message is left in ctx->aerr
+static int out_write(struct emas_ctx *ctx, struct emas_out *out)
+{
+	int res;
+	FILE *f = out->f;
+
+	if (!f) {
+		if (!strcmp(out->name, "-")) {
+			f = stdout;
+		} else {
+			char *path = ctx_path(ctx, out->name);
+			f = path ? fopen(path, "wb") : NULL;
+			free(path);
+			if (!f) {
+				aaerror(ctx, NULL, "Cannot open output file '%s' for writing", out->name);
+				return 1;
+			}
+		}
+	}
+
+	switch (out->type) {
+		case O_RAW:
+			res = writer_raw(ctx, f);
+			break;
+		case O_DEBUG:
+			res = writer_debug(ctx, f);
+			break;
+		case O_KEYS:
+			res = writer_keys(ctx, f);
+			break;
+		case O_OBJ:
+			res = writer_obj(ctx, f);
+			break;
+		case O_SEG:
+			res = writer_seg(ctx, f);
+			break;
+		case O_LISTING:
+			res = writer_listing(ctx, f);
+			break;
+		case O_MAP:
+			res = writer_map(ctx, f);
+			break;
+		case O_LINES:
+			res = writer_lines(ctx, f);
+			break;
+		default:
+			aaerror(ctx, NULL, "Unknown output type.");
+			res = 1;
+			break;
+	}
+
+	if ((f == out->f) || (f == stdout)) {
+		fflush(f);
+	} else {
+		fclose(f);
+	}
+
+	return res;
+}
+
+// Output written by a separate thread
+struct out_job {
+	struct emas_ctx *ctx;
+	struct emas_out *out;
+	int res;
+	char aerr[MAX_ERRLEN+1];
+	int started;
+	pthread_t thread;
+};
+
+// -----------------------------------------------------------------------
+// Writers only read the assembled program. Each one uses a private
+// copy of the context, so errors don't get mixed up.
+static void * out_worker(void *ptr)
+{
+	struct out_job *j = ptr;
+	struct emas_ctx *w = malloc(sizeof(struct emas_ctx));
+
+	if (!w) {
+		strcpy(j->aerr, "Cannot allocate memory for the writer");
+		j->res = 1;
+		return NULL;
+	}
+
+	*w = *j->ctx;
+	w->aerr[0] = '\0';
+	j->res = out_write(w, j->out);
+	strcpy(j->aerr, w->aerr);
+	free(w);
+
+	return NULL;
+}
+
+// -----------------------------------------------------------------------
+// Write the output and all additional ones. Outputs that go to files
+// are written in parallel, streams are written in order by the calling
+// thread. Errors are reported in the order outputs were given.
+static int emas_write(struct emas_ctx *ctx, struct emas_out *out)
+{
+	int ret = 0;
+	int count = ctx->out_count + (out ? 1 : 0);
+
+	if (!count) {
+		return 0;
+	}
+
+	struct out_job *jobs = calloc(count, sizeof(struct out_job));
+	if (!jobs) {
+		fprintf(ctx->errf, "Cannot allocate memory for the writers\n");
+		return 1;
+	}
+
+	for (int i=0 ; i<count ; i++) {
+		struct out_job *j = jobs + i;
+		j->ctx = ctx;
+		j->out = out ? (i ? ctx->outs + i-1 : out) : ctx->outs + i;
+		// keep debug output in order
+		if ((count > 1) && !ctx->aadebug && !j->out->f && strcmp(j->out->name, "-")) {
+			j->started = !pthread_create(&j->thread, NULL, out_worker, j);
+		}
+	}
+
+	for (int i=0 ; i<count ; i++) {
+		struct out_job *j = jobs + i;
+		if (j->started) {
+			pthread_join(j->thread, NULL);
+		} else {
+			out_worker(j);
+		}
+		if (j->res) {
+			fprintf(ctx->errf, "%s\n", j->aerr);
+			ret = 1;
+		}
+	}
+
+	free(jobs);
+
+	return ret;
+}
+
+// -----------------------------------------------------------------------
+static int emas_parse(struct emas_ctx *ctx, FILE *inf, char *name)
+{
+	int res;
+
+	loc_push(ctx, name);
+
+	AADEBUG(ctx, "==== Include search dirs ==================");
+	struct st *i = ctx->inc_paths;
+	while (i) {
+		AADEBUG(ctx, "%s", i->str);
+		i = i->next;
+	}
+
+	AADEBUG(ctx, "==== Parse ================================");
+	yyset_in(inf, ctx->scanner);
+	res = yyparse(ctx->scanner, ctx);
+	if (res) {
+		return 1;
+	}
+
+	if (!ctx->program) { // shouldn't happen - parser should always produce a program (even an empty one)
+		fprintf(ctx->errf, "Parse produced empty tree.\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Get types of all outputs that are going to be written
+static int out_types(struct emas_ctx *ctx, struct emas_out *out)
+{
+	int types = out ? out->type : 0;
+
+	for (int i=0 ; i<ctx->out_count ; i++) {
+		types |= ctx->outs[i].type;
+	}
+
+	return types;
+}
+
+// -----------------------------------------------------------------------
+// Assemble the parsed program and write the output
+static int emas_build(struct emas_ctx *ctx, struct emas_out *out)
+{
+	int types = out_types(ctx, out);
+
+	// modules are linked later, external symbols are resolved then
+	ctx->relocatable = (types & O_OBJ) ? 1 : 0;
+	if (ctx->relocatable && (types & (O_RAW | O_SEG))) {
+		fprintf(ctx->errf, "Object output cannot be combined with raw or segmented image output.\n");
+		return 1;
+	}
+
+	// resolve all name references to symbol table entries once
+	bind_names(ctx, ctx->program);
+
+	if (assemble(ctx, ctx->program)) {
+		fprintf(ctx->errf, "%s\n", ctx->aerr);
+		return 1;
+	}
+
+	if (ctx->sym_stats) {
+		dh_dump_stats(ctx->sym, ctx->errf);
+	}
+
+	if (emas_write(ctx, out)) {
+		return 1;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int emas_run(struct emas_ctx *ctx, FILE *inf, char *name, struct emas_out *out)
+{
+	if (emas_parse(ctx, inf, name)) {
+		return 1;
+	}
+
+	return emas_build(ctx, out);
+}
+
+// -----------------------------------------------------------------------
+static FILE * source_open(struct emas_ctx *ctx, char *source)
+{
+	FILE *inf;
+
+	if (!source) {
+		return stdin;
+	}
+
+	char *path = ctx_path(ctx, source);
+	inf = path ? fopen(path, "r") : NULL;
+	free(path);
+	if (!inf) {
+		fprintf(ctx->errf, "Cannot open source file: '%s'\n", source);
+	}
+
+	return inf;
+}
+
+// -----------------------------------------------------------------------
+// Assemble the source file (stdin if source is NULL) and write the output.
+// Output file is opened only when assembly succeeds.
+int emas_assemble(struct emas_ctx *ctx, char *source, struct emas_opts *opts, struct emas_out *out)
+{
+	int ret = 1;
+	FILE *inf;
+
+	if (ctx_setup(ctx, opts)) {
+		goto cleanup;
+	}
+
+	inf = source_open(ctx, source);
+	if (!inf) {
+		goto cleanup;
+	}
+
+	ctx->source = source;
+	ret = emas_run(ctx, inf, source ? source : "(stdin)", out);
+
+	if (inf != stdin) fclose(inf);
+
+cleanup:
+	ctx_cleanup(ctx);
+
+	return ret;
+}
+
+// -----------------------------------------------------------------------
+// Assemble source read from an already opened stream.
+// Name is used in diagnostics only.
+int emas_assemble_stream(struct emas_ctx *ctx, FILE *inf, char *name, struct emas_opts *opts, struct emas_out *out)
+{
+	int ret = 1;
+
+	if (!ctx_setup(ctx, opts)) {
+		ret = emas_run(ctx, inf, name, out);
+	}
+
+	ctx_cleanup(ctx);
+
+	return ret;
+}
+
+// -----------------------------------------------------------------------
+// Prepare the context for assembling a variant: start with a fresh symbol
+// table and a copy of the parsed program, so the parse tree stays intact.
+static int variant_setup(struct emas_ctx *ctx, struct emas_opts *opts, struct emas_variant *v, struct st *parsed, int cpu, int ic_max)
+{
+	sym_clear(ctx);
+	ctx->entry = NULL;
+	ctx->fixup_count = 0;
+	ctx->unresolved = NULL;
+	ctx->aerr[0] = '\0';
+	ctx->ic = 0;
+	ctx->cpu = cpu;
+	ctx->ic_max = ic_max;
+
+	if (v->cpu != CPU_DEFAULT) {
+		ctx->cpu = CPU_DEFAULT;
+		if (prog_cpu(ctx, v->cpu, CPU_FORCED)) {
+			fprintf(ctx->errf, "Unknown cpu type: %i.\n", v->cpu);
+			return -1;
+		}
+	}
+
+	// variant constants go last, so they override the common ones
+	defs_add(ctx, opts->defs);
+	defs_add(ctx, v->defs);
+
+	ctx->program = st_clone(ctx, parsed);
+	if (!ctx->program) {
+		fprintf(ctx->errf, "Cannot copy the program tree.\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Parse the source file (stdin if source is NULL) once and assemble it
+// for each of the variants. Returns the number of variants that failed
+// or -1 if the source could not be parsed.
+int emas_assemble_variants(struct emas_ctx *ctx, char *source, struct emas_opts *opts, struct emas_variant *variants, int count)
+{
+	int ret = -1;
+	int res;
+	FILE *inf;
+	struct st *parsed;
+	int cpu, ic_max;
+
+	if (ctx_setup(ctx, opts)) {
+		goto cleanup;
+	}
+
+	inf = source_open(ctx, source);
+	if (!inf) {
+		goto cleanup;
+	}
+
+	ctx->source = source;
+	res = emas_parse(ctx, inf, source ? source : "(stdin)");
+
+	if (inf != stdin) fclose(inf);
+
+	if (res) {
+		goto cleanup;
+	}
+
+	// .cpu directive is handled by the parser, variants start from there
+	parsed = ctx->program;
+	cpu = ctx->cpu;
+	ic_max = ctx->ic_max;
+
+	ret = 0;
+	for (int i=0 ; i<count ; i++) {
+		struct emas_variant *v = variants + i;
+		AADEBUG(ctx, "==== Variant: %s ============================", v->name);
+		if (variant_setup(ctx, opts, v, parsed, cpu, ic_max) || emas_build(ctx, &v->out)) {
+			fprintf(ctx->errf, "Variant '%s' failed.\n", v->name);
+			ret++;
+		}
+		st_drop(ctx, ctx->program);
+		ctx->program = parsed;
+	}
+
+cleanup:
+	ctx_cleanup(ctx);
+
+	return ret;
+}
+
+// -----------------------------------------------------------------------
+// Get memory statistics of the last assembly run
+void emas_get_stats(struct emas_ctx *ctx, struct emas_stats *stats)
+{
+	stats->arena_bytes = ctx->arena.bytes;
+	stats->arena_used = ctx->arena.used;
+	stats->nodes_peak = ctx->arena.nodes_peak;
+	stats->nodes_total = ctx->arena.nodes_total;
+	stats->nodes_reused = ctx->arena.nodes_reused;
+}
+
+// -----------------------------------------------------------------------
+int emas_list_add(char ***list, char *str)
+{
+	int count = 0;
+
+	while (*list && (*list)[count]) {
+		count++;
+	}
+
+	char **l = realloc(*list, (count+2) * sizeof(char*));
+	if (!l) {
+		return -1;
+	}
+
+	l[count] = strdup(str);
+	l[count+1] = NULL;
+	*list = l;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+void emas_list_free(char **list)
+{
+	char **s;
+
+	for (s=list ; s && *s ; s++) {
+		free(*s);
+	}
+	free(list);
+}
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,95 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef LIBEMAS_H
+#define LIBEMAS_H
+
+#include <stdio.h>
+
+struct emas_ctx;
+
+enum cpu_types {
+	CPU_DEFAULT			= 0,
+	CPU_FORCED			= 1 << 0,
+	CPU_MERA400			= 1 << 1,
+	CPU_MX16			= 1 << 2,
+};
+
+enum output_types {
+	O_DEBUG	= 1,
+	O_RAW	= 2,
+	O_KEYS	= 4,
+	O_OBJ	= 8,
+	O_SEG	= 16,
+	O_LISTING	= 32,
+	O_MAP	= 64,
+	O_LINES	= 128,
+};
+
+struct emas_opts {
+	int cpu;			// CPU type (see enum cpu_types), CPU_DEFAULT lets .cpu decide
+	char **inc_paths;	// NULL-terminated list of include directories
+	char **defs;		// NULL-terminated list of "name[=value]" constants
+	FILE *errf;			// diagnostics go here (stderr if NULL)
+	int debug;			// print debug information (lots of)
+	char *cwd;			// relative paths are resolved against this directory (if set)
+	FILE * (*inc_open)(const char *path, void *data);	// opens included files (fopen() if NULL)
+	void *inc_open_data;
+	int sym_stats;		// print symbol table statistics to errf after assembly
+	int jobs;			// worker threads used for encoding (1 if 0)
+	struct emas_out *outs;	// additional outputs written from the same assembly
+	int out_count;
+};
+
+struct emas_out {
+	int type;			// output type (see enum output_types)
+	char *name;			// output file name ("-" for stdout)
+	FILE *f;			// use this stream instead of opening the file
+};
+
+struct emas_variant {
+	char *name;			// variant name (used in diagnostics)
+	int cpu;			// CPU type, CPU_DEFAULT keeps the one from emas_opts or .cpu
+	char **defs;		// NULL-terminated list of "name[=value]" constants (on top of emas_opts ones)
+	struct emas_out out;	// where the variant output goes
+};
+
+struct emas_stats {
+	size_t arena_bytes;		// memory reserved for the syntax tree
+	size_t arena_used;		// memory actually used
+	size_t nodes_peak;		// max. syntax tree nodes alive at a time
+	size_t nodes_total;		// nodes created
+	size_t nodes_reused;	// nodes created in place of dropped ones
+};
+
+int emas_init();
+void emas_shutdown();
+
+struct emas_ctx * emas_create();
+void emas_destroy(struct emas_ctx *ctx);
+int emas_assemble(struct emas_ctx *ctx, char *source, struct emas_opts *opts, struct emas_out *out);
+int emas_assemble_stream(struct emas_ctx *ctx, FILE *inf, char *name, struct emas_opts *opts, struct emas_out *out);
+int emas_assemble_variants(struct emas_ctx *ctx, char *source, struct emas_opts *opts, struct emas_variant *variants, int count);
+void emas_get_stats(struct emas_ctx *ctx, struct emas_stats *stats);
+
+int cpu_by_name(char *cpu_name);
+int emas_list_add(char ***list, char *str);
+void emas_list_free(char **list);
+
+#endif
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,70 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+#ifndef LINES_H
+#define LINES_H
+
+// Line table (debug information), as written by "emas -O lines"
+// or "emas -g <file>". It maps addresses to source lines.
+// File consists of 16-bit big-endian words, 32-bit values are stored
+// as two words, most significant one first.
+//
+// Table is made of rows: each one says that words starting at 'addr'
+// (up to the next row address) come from 'line' of 'file'. Addresses
+// without a source (gaps and the program end) have line 0 and file
+// LINES_NO_FILE. Rows are in address order and grouped in blocks of
+// LINES_BLOCK_ROWS. First row of a block is stored in the block table,
+// so lookup is a binary search over blocks and then a short scan of
+// the block rows.
+//
+// header:
+//   magic[2]      : LINES_MAGIC_HI, LINES_MAGIC_LO ("EMLN")
+//   version       : LINES_VERSION
+//   flags         : unused, 0
+//   rows (32)     : number of rows
+//   blocks (32)   : number of blocks
+//   files (32)    : number of source files
+//   data (32)     : row data position (in words from the file start)
+//   strings (32)  : string table position (in words from the file start)
+// blocks:
+//   addr (32)     : address of the first row
+//   line (32)     : line of the first row
+//   file          : file of the first row
+//   offset (32)   : position of the remaining block rows in row data (in bytes)
+// files:
+//   name (32)     : name position in the string table (in bytes)
+// row data (remaining rows of each block, as differences to the previous row):
+//   addr          : unsigned varint: (address difference << 1) | file changed
+//   file          : unsigned varint: file index (only if changed)
+//   line          : signed varint: line difference
+// string table:
+//   zero-terminated strings, padded with zero to full words
+//
+// Varints are little-endian groups of 7 bits, high bit set in all bytes
+// but the last one. Signed values are zigzag-encoded (0, -1, 1, -2, ...).
+
+#define LINES_MAGIC_HI	0x454d
+#define LINES_MAGIC_LO	0x4c4e
+#define LINES_VERSION	1
+#define LINES_HEADER_WORDS	14
+#define LINES_BLOCK_WORDS	7
+#define LINES_BLOCK_ROWS	32
+
+#define LINES_NO_FILE	0xffff
+
+#endif
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,61 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+#ifndef MAP_H
+#define MAP_H
+
+// Symbol map, as written by "emas -O map" or "emas -m <file>".
+// File consists of 16-bit big-endian words, 32-bit values are stored
+// as two words, most significant one first. Symbol records have fixed
+// size, so both tables can be binary searched right in the file.
+//
+// header:
+//   magic[2]      : MAP_MAGIC_HI, MAP_MAGIC_LO ("EMMP")
+//   version       : MAP_VERSION
+//   flags         : unused, 0
+//   syms (32)     : number of symbols
+//   files (32)    : number of source files
+//   strings (32)  : string table position (in words from the file start)
+// symbols (sorted by value, symbols with the same value by name):
+//   value (32)    : symbol value (signed)
+//   flags         : MAP_SYM_* flags
+//   file          : index of the file symbol is defined in (or MAP_NO_FILE)
+//   line (32)     : line symbol is defined at (0 if unknown)
+//   name (32)     : name position in the string table (in bytes)
+// name index (symbols sorted by name):
+//   sym (32)      : symbol index
+// files:
+//   name (32)     : name position in the string table (in bytes)
+// string table:
+//   zero-terminated strings, padded with zero to full words
+
+#define MAP_MAGIC_HI	0x454d
+#define MAP_MAGIC_LO	0x4d50
+#define MAP_VERSION		1
+#define MAP_HEADER_WORDS	10
+#define MAP_SYM_WORDS	8
+
+enum map_sym_flags {
+	MAP_SYM_RELATIVE	= 1 << 0,	// value is relative to the program start
+	MAP_SYM_GLOBAL		= 1 << 1,	// symbol is global
+	MAP_SYM_VARIABLE	= 1 << 2,	// symbol is a variable (value is the last one assigned)
+};
+
+#define MAP_NO_FILE	0xffff
+
+#endif
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,69 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef OBJ_H
+#define OBJ_H
+
+// Relocatable object file (module), as written by "emas -O obj"
+// and read by the linker. File consists of 16-bit big-endian words,
+// 32-bit values are stored as two words, most significant one first.
+//
+// header:
+//   magic[2]      : OBJ_MAGIC_HI, OBJ_MAGIC_LO ("EMOB")
+//   version       : OBJ_VERSION
+//   cpu           : CPU type the module was assembled for (enum cpu_types)
+//   size (32)     : module size in words (IC after the last word)
+//   chunks (32)   : number of section chunks
+//   syms (32)     : number of symbols
+//   relocs (32)   : number of relocations
+// section chunks (module has a single section, chunks are in address order):
+//   addr (32)     : chunk address, relative to the module start
+//   len (32)      : chunk length in words
+//   flags         : OBJ_CHUNK_FILL if the chunk is filled with a value
+//   fill          : fill value
+//   data[len]     : chunk contents (only if not a fill)
+// symbols (sorted by name):
+//   flags         : OBJ_SYM_* flags
+//   value         : symbol value (exported symbols)
+//   len           : name length in bytes
+//   name[]        : symbol name, padded with zero to full words
+// relocations (in address order):
+//   addr (32)     : address of the word to relocate, relative to the module start
+//   sym (32)      : symbol index or OBJ_SYM_SECTION for the module start
+//   addend (32)   : signed value added to the symbol value
+
+#define OBJ_MAGIC_HI	0x454d
+#define OBJ_MAGIC_LO	0x4f42
+#define OBJ_VERSION		1
+#define OBJ_HEADER_WORDS	12
+
+enum obj_chunk_flags {
+	OBJ_CHUNK_FILL		= 1 << 0,
+};
+
+enum obj_sym_flags {
+	OBJ_SYM_EXPORT		= 1 << 0,	// defined in this module
+	OBJ_SYM_IMPORT		= 1 << 1,	// defined in another module
+	OBJ_SYM_RELATIVE	= 1 << 2,	// value is relative to the module start
+};
+
+#define OBJ_SYM_SECTION	0xffffffff
+
+#endif
+
+// vim: tabstop=4 autoindent
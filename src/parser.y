@@ -22,18 +22,17 @@
 
 #include "st.h"
 #include "prog.h"
+#include "ctx.h"
 #include "parser_utils.h"
 
-extern int str_len;
-
-int yylex(void);
-
 %}
 
 %code requires {
 
 #include <inttypes.h>
 
+struct emas_ctx;
+
 typedef struct YYLTYPE {
 	int first_line;
 	int first_column;
@@ -57,12 +56,16 @@ typedef struct YYLTYPE {
 	} \
 }
 
+%define api.pure full
 %define parse.error verbose
 %locations
+%parse-param { void *scanner } { struct emas_ctx *ctx }
+%lex-param { void *scanner }
 
 %union {
 	int64_t v;
 	char *s;
+	char *a;
 	double f;
 	struct st *t;
 };
@@ -80,8 +83,8 @@ typedef struct YYLTYPE {
 %token <v> INT "integer"
 %token <f> FLOAT "float"
 %token <v> REG "register"
-%token <s> NAME "symbol"
-%token <s> LABEL "label"
+%token <a> NAME "symbol"
+%token <a> LABEL "label"
 
 %token PROG NORM NONE BLOB
 
@@ -140,46 +143,50 @@ typedef struct YYLTYPE {
 %type <t> norm normval expr exprs
 %type <t> struct_field struct_fields
 
-%destructor { st_drop($$); } <t>
+%destructor { st_drop(ctx, $$); } <t>
 %destructor { free($$); } <s>
 
+%code {
+int yylex(YYSTYPE *lvalp, YYLTYPE *llocp, void *scanner);
+}
+
 %%
 
 /* ---- PROGRAM ---------------------------------------------------------- */
 
 program:
-	lines { program = $1; }
+	lines { ctx->program = $1; }
 	;
 
 lines:
-	/* empty */ { $$ = st_int(N_PROG, 0); }
+	/* empty */ { $$ = st_int(ctx, N_PROG, 0); }
 	| lines line { $$ = st_arg_app($1, $2); }
 	;
 
 line:
-	LABEL { $$ = st_str(N_LABEL, $1); free($1); }
-	| op
-	| pragma
+	LABEL { $$ = st_atom(ctx, N_LABEL, $1); st_loc_set(ctx, $$, &@1); }
+	| op { $$ = $1; st_loc_set(ctx, $$, &@1); }
+	| pragma { $$ = $1; st_loc_set(ctx, $$, &@1); }
 	;
 
 /* ---- OP --------------------------------------------------------------- */
 
 op:
-	OP_RN REG ',' norm	{ $$ = compose_norm(N_OP_RN, $1, $2<<6, $4); }
-	| OP_N norm			{ $$ = compose_norm(N_OP_R, $1, 0, $2); }
-	| OP_RT REG ',' expr{ $$ = st_int(N_OP_RT, $1|($2<<6)); st_arg_app($$, $4); }
-	| OP_T expr			{ $$ = st_int(N_OP_T, $1); st_arg_app($$, $2); }
-	| OP_SHC REG ','expr{ $$ = st_int(N_OP_SHC, $1|($2<<6)); st_arg_app($$, $4); }
-	| OP_R REG			{ $$ = st_int(N_OP_R, $1|($2<<6)); }
-	| OP__				{ $$ = st_int(N_OP__, $1); }
-	| OP_X				{ $$ = st_int(N_OP_X, $1); }
-	| OP_BLC expr		{ $$ = st_int(N_OP_BLC, $1); st_arg_app($$, $2); }
-	| OP_BRC expr		{ $$ = st_int(N_OP_BRC, $1); st_arg_app($$, $2); }
-	| OP_EXL expr		{ $$ = st_int(N_OP_EXL, $1); st_arg_app($$, $2); }
-	| OP_NRF			{ $$ = st_int(N_OP_NRF, $1); st_arg_app($$, st_int(N_INT, 255)); }
-	| OP_NRF expr		{ $$ = st_int(N_OP_NRF, $1); st_arg_app($$, $2); }
-	| OP_HLT			{ $$ = st_int(N_OP_HLT, $1); st_arg_app($$, st_int(N_INT, 0)); }
-	| OP_HLT expr		{ $$ = st_int(N_OP_HLT, $1); st_arg_app($$, $2); }
+	OP_RN REG ',' norm	{ $$ = compose_norm(ctx, N_OP_RN, $1, $2<<6, $4); }
+	| OP_N norm			{ $$ = compose_norm(ctx, N_OP_R, $1, 0, $2); }
+	| OP_RT REG ',' expr{ $$ = st_int(ctx, N_OP_RT, $1|($2<<6)); st_arg_app($$, $4); }
+	| OP_T expr			{ $$ = st_int(ctx, N_OP_T, $1); st_arg_app($$, $2); }
+	| OP_SHC REG ','expr{ $$ = st_int(ctx, N_OP_SHC, $1|($2<<6)); st_arg_app($$, $4); }
+	| OP_R REG			{ $$ = st_int(ctx, N_OP_R, $1|($2<<6)); }
+	| OP__				{ $$ = st_int(ctx, N_OP__, $1); }
+	| OP_X				{ $$ = st_int(ctx, N_OP_X, $1); }
+	| OP_BLC expr		{ $$ = st_int(ctx, N_OP_BLC, $1); st_arg_app($$, $2); }
+	| OP_BRC expr		{ $$ = st_int(ctx, N_OP_BRC, $1); st_arg_app($$, $2); }
+	| OP_EXL expr		{ $$ = st_int(ctx, N_OP_EXL, $1); st_arg_app($$, $2); }
+	| OP_NRF			{ $$ = st_int(ctx, N_OP_NRF, $1); st_arg_app($$, st_int(ctx, N_INT, 255)); }
+	| OP_NRF expr		{ $$ = st_int(ctx, N_OP_NRF, $1); st_arg_app($$, $2); }
+	| OP_HLT			{ $$ = st_int(ctx, N_OP_HLT, $1); st_arg_app($$, st_int(ctx, N_INT, 0)); }
+	| OP_HLT expr		{ $$ = st_int(ctx, N_OP_HLT, $1); st_arg_app($$, $2); }
 	;
 
 norm:
@@ -188,12 +195,12 @@ norm:
 	;
 
 normval:
-	REG { $$ = st_int(N_NORM, $1); } // rC
-	| expr { $$ = st_int(N_NORM, 0); st_arg_app($$, $1); } // val
-	| REG '+' REG { $$ = st_int(N_NORM, $1|($3<<3)); } // rC + rB
-	| REG '+' expr { $$ = st_int(N_NORM, $1<<3); st_arg_app($$, $3); } // rB + val
-	| expr '+' REG { $$ = st_int(N_NORM, $3<<3); st_arg_app($$, $1); } // val + rB
-	| REG '-' expr { $$ = st_int(N_NORM, $1<<3); st_arg_app($$, st_arg(N_UMINUS, $3, NULL)); } // rB + (-val)
+	REG { $$ = st_int(ctx, N_NORM, $1); } // rC
+	| expr { $$ = st_int(ctx, N_NORM, 0); st_arg_app($$, $1); } // val
+	| REG '+' REG { $$ = st_int(ctx, N_NORM, $1|($3<<3)); } // rC + rB
+	| REG '+' expr { $$ = st_int(ctx, N_NORM, $1<<3); st_arg_app($$, $3); } // rB + val
+	| expr '+' REG { $$ = st_int(ctx, N_NORM, $3<<3); st_arg_app($$, $1); } // val + rB
+	| REG '-' expr { $$ = st_int(ctx, N_NORM, $1<<3); st_arg_app($$, compose_expr(ctx, N_UMINUS, $3, NULL)); } // rB + (-val)
 	;
 
 /* ---- PRAGMA ----------------------------------------------------------- */
@@ -201,32 +208,31 @@ normval:
 pragma:
 	P_CPU NAME {
 		$$ = NULL;
-		int res = prog_cpu($2, 0);
+		int res = prog_cpu(ctx, cpu_by_name($2), 0);
 		if (res > 0) {
-			yyerror("Unknown CPU type '%s'.", $2);
+			yyerror(&yylloc, scanner, ctx, "Unknown CPU type '%s'.", $2);
 		} else if (res < 0) {
-			yyerror("CPU type already set.");
+			yyerror(&yylloc, scanner, ctx, "CPU type already set.");
 		}
-		free($2);
 		if (res) YYABORT;
 	}
-	| P_EQU NAME expr { $$ = st_str(N_EQU, $2); st_arg_app($$, $3); free($2); }
-	| P_CONST NAME expr { $$ = st_str(N_CONST, $2); st_arg_app($$, $3); free($2); }
-	| P_WORD exprs { $$ = compose_list(N_WORD, $2); }
-	| P_DWORD exprs { $$ = compose_list(N_DWORD, $2); }
-	| P_FLOAT exprs { $$ = compose_list(N_FLOAT, $2); }
-	| P_ASCII STRING { $$ = st_strval(N_ASCII, $2, str_len); free($2); }
-	| P_ASCIIZ STRING { $$ = st_strval(N_ASCIIZ, $2, str_len); free($2); }
-	| P_RES expr { $$ = st_arg(N_RES, $2, NULL); }
-	| P_RES expr ',' expr { $$ = st_arg(N_RES, $2, $4, NULL); }
-	| P_ORG expr { $$ = st_arg(N_ORG, $2, NULL); }
-	| P_ENTRY expr { $$ = st_arg(N_ENTRY, $2, NULL); }
-	| P_GLOBAL NAME { $$ = st_str(N_GLOBAL, $2); free($2); }
-	| P_IFDEF NAME lines P_ENDIF { $$ = st_str(N_IFDEF, $2); st_arg_app($$, $3); st_arg_app($$, st_int(N_PROG, 0)); free($2); }
-	| P_IFDEF NAME lines P_ELSE lines P_ENDIF { $$ = st_str(N_IFDEF, $2); st_arg_app($$, $3); st_arg_app($$, $5); free($2); }
-	| P_IFNDEF NAME lines P_ENDIF { $$ = st_str(N_IFDEF, $2); st_arg_app($$, st_int(N_PROG, 0)); st_arg_app($$, $3); free($2); }
-	| P_IFNDEF NAME lines P_ELSE lines P_ENDIF { $$ = st_str(N_IFDEF, $2); st_arg_app($$, $5); st_arg_app($$, $3); free($2); }
-	| P_STRUCT LABEL struct_fields P_ENDSTRUCT { $$ = st_str(N_STRUCT, $2); free($2); st_arg_app($$, $3); }
+	| P_EQU NAME expr { $$ = st_atom(ctx, N_EQU, $2); st_arg_app($$, $3); }
+	| P_CONST NAME expr { $$ = st_atom(ctx, N_CONST, $2); st_arg_app($$, $3); }
+	| P_WORD exprs { $$ = compose_list(ctx, N_WORD, $2); }
+	| P_DWORD exprs { $$ = compose_list(ctx, N_DWORD, $2); }
+	| P_FLOAT exprs { $$ = compose_list(ctx, N_FLOAT, $2); }
+	| P_ASCII STRING { $$ = st_strval(ctx, N_ASCII, $2, ctx->str_len); free($2); }
+	| P_ASCIIZ STRING { $$ = st_strval(ctx, N_ASCIIZ, $2, ctx->str_len); free($2); }
+	| P_RES expr { $$ = st_arg(ctx, N_RES, $2, NULL); }
+	| P_RES expr ',' expr { $$ = st_arg(ctx, N_RES, $2, $4, NULL); }
+	| P_ORG expr { $$ = st_arg(ctx, N_ORG, $2, NULL); }
+	| P_ENTRY expr { $$ = st_arg(ctx, N_ENTRY, $2, NULL); }
+	| P_GLOBAL NAME { $$ = st_atom(ctx, N_GLOBAL, $2); }
+	| P_IFDEF NAME lines P_ENDIF { $$ = st_atom(ctx, N_IFDEF, $2); st_arg_app($$, $3); st_arg_app($$, st_int(ctx, N_PROG, 0)); }
+	| P_IFDEF NAME lines P_ELSE lines P_ENDIF { $$ = st_atom(ctx, N_IFDEF, $2); st_arg_app($$, $3); st_arg_app($$, $5); }
+	| P_IFNDEF NAME lines P_ENDIF { $$ = st_atom(ctx, N_IFDEF, $2); st_arg_app($$, st_int(ctx, N_PROG, 0)); st_arg_app($$, $3); }
+	| P_IFNDEF NAME lines P_ELSE lines P_ENDIF { $$ = st_atom(ctx, N_IFDEF, $2); st_arg_app($$, $5); st_arg_app($$, $3); }
+	| P_STRUCT LABEL struct_fields P_ENDSTRUCT { $$ = st_atom(ctx, N_STRUCT, $2); st_arg_app($$, $3); }
 	;
 
 /* ---- STRUCT ----------------------------------------------------------- */
@@ -237,34 +243,34 @@ struct_fields:
 	;
 
 struct_field:
-	LABEL P_RES expr { $$ = st_str(N_STRUCT_FIELD, $1); free($1); st_arg_app($$, $3); }
+	LABEL P_RES expr { $$ = st_atom(ctx, N_STRUCT_FIELD, $1); st_arg_app($$, $3); }
 
 /* ---- EXPR ------------------------------------------------------------- */
 
 expr:
-	INT { $$ = st_int(N_INT, $1); }
-	| FLOAT { $$ = st_float(N_FLO, $1); }
-	| NAME { $$ = st_str(N_NAME, $1); free($1); }
-	| CURLOC { $$ = st_int(N_CURLOC, 0); }
+	INT { $$ = st_int(ctx, N_INT, $1); }
+	| FLOAT { $$ = st_float(ctx, N_FLO, $1); }
+	| NAME { $$ = st_atom(ctx, N_NAME, $1); }
+	| CURLOC { $$ = st_int(ctx, N_CURLOC, 0); }
 	| '(' expr ')' { $$ = $2; }
-	| expr '+' expr { $$ = st_arg(N_PLUS, $1, $3, NULL); }
-	| expr '-' expr { $$ = st_arg(N_MINUS, $1, $3, NULL); }
-	| expr '*' expr { $$ = st_arg(N_MUL, $1, $3, NULL); }
-	| expr '/' expr { $$ = st_arg(N_DIV, $1, $3, NULL); }
-	| expr '%' expr { $$ = st_arg(N_REM, $1, $3, NULL); }
-	| '-' expr %prec UMINUS { $$ = st_arg(N_UMINUS, $2, NULL, NULL); }
-	| expr '\\' expr { $$ = st_arg(N_SCALE, $1, $3, NULL); }
-	| expr LSHIFT expr { $$ = st_arg(N_LSHIFT, $1, $3, NULL); }
-	| expr RSHIFT expr { $$ = st_arg(N_RSHIFT, $1, $3, NULL); }
-	| expr '&' expr { $$ = st_arg(N_AND, $1, $3, NULL); }
-	| expr '|' expr { $$ = st_arg(N_OR, $1, $3, NULL); }
-	| expr '^' expr { $$ = st_arg(N_XOR, $1, $3, NULL); }
-	| '~' expr { $$ = st_arg(N_NEG, $2, NULL, NULL); }
+	| expr '+' expr { $$ = compose_expr(ctx, N_PLUS, $1, $3); }
+	| expr '-' expr { $$ = compose_expr(ctx, N_MINUS, $1, $3); }
+	| expr '*' expr { $$ = compose_expr(ctx, N_MUL, $1, $3); }
+	| expr '/' expr { $$ = compose_expr(ctx, N_DIV, $1, $3); }
+	| expr '%' expr { $$ = compose_expr(ctx, N_REM, $1, $3); }
+	| '-' expr %prec UMINUS { $$ = compose_expr(ctx, N_UMINUS, $2, NULL); }
+	| expr '\\' expr { $$ = compose_expr(ctx, N_SCALE, $1, $3); }
+	| expr LSHIFT expr { $$ = compose_expr(ctx, N_LSHIFT, $1, $3); }
+	| expr RSHIFT expr { $$ = compose_expr(ctx, N_RSHIFT, $1, $3); }
+	| expr '&' expr { $$ = compose_expr(ctx, N_AND, $1, $3); }
+	| expr '|' expr { $$ = compose_expr(ctx, N_OR, $1, $3); }
+	| expr '^' expr { $$ = compose_expr(ctx, N_XOR, $1, $3); }
+	| '~' expr { $$ = compose_expr(ctx, N_NEG, $2, NULL); }
 	;
 
 exprs:
-	expr
-	| expr ',' exprs { $$ = st_app($1, $3); }
+	expr { $$ = st_arg(ctx, N_PROG, $1, NULL); } // list holder, appended to in O(1)
+	| exprs ',' expr { $$ = st_arg_app($1, $3); }
 	;
 
 %%
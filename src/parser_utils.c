@@ -17,55 +17,183 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
 #include <strings.h>
 #include <stdarg.h>
 
 #include "prog.h"
 #include "parser.h"
-
-extern int lexer_err_reported;
+#include "parser_utils.h"
+#include "ctx.h"
 
 // -----------------------------------------------------------------------
-void yyerror(const char *s, ...)
+void yyerror(YYLTYPE *lloc, void *scanner, struct emas_ctx *ctx, const char *s, ...)
 {
-	if (lexer_err_reported) return;
+	if (ctx->lexer_err_reported) return;
 	va_list ap;
 	va_start(ap, s);
-	fprintf(stderr, "%s:%d:%d: ", yylloc.filename, yylloc.first_line, yylloc.first_column);
-	vfprintf(stderr, s, ap);
-	fprintf(stderr, "\n");
+	fprintf(ctx->errf, "%s:%d:%d: ", lloc->filename, lloc->first_line, lloc->first_column);
+	vfprintf(ctx->errf, s, ap);
+	fprintf(ctx->errf, "\n");
 	va_end(ap);
 }
 
 // -----------------------------------------------------------------------
-struct st * compose_norm(int type, int opcode, int reg, struct st *norm)
+// Create a data run node for a list of element expressions. Elements
+// with literal values are encoded into the run buffer right away,
+// the rest is left for the evaluation (element IC holds its offset in the run).
+static struct st * compose_data(struct emas_ctx *ctx, int type, struct st *elems)
+{
+	struct st *t = st_arg(ctx, type, NULL);
+	struct st *e, *next;
+	int esize = data_elem_size(type);
+	int count = 0;
+
+	for (e=elems ; e ; e=e->next) {
+		count++;
+	}
+
+	t->size = count * esize;
+	t->flags |= ST_DATA;
+	if (type == N_WORD) {
+		t->flags |= ST_SIGNED;
+	}
+	int words = st_data_words(t);
+	t->data = arena_alloc(&ctx->arena, words * sizeof(uint16_t));
+	memset(t->data, 0, words * sizeof(uint16_t));
+
+	for (e=elems, count=0 ; e ; e=next, count++) {
+		next = e->next;
+		e->next = NULL;
+		e->ic = count * esize;
+		if (((e->type == N_INT) || (e->type == N_FLO)) && !data_put(ctx, t, e, 0)) {
+			st_drop(ctx, e);
+		} else {
+			st_arg_app(t, e);
+		}
+	}
+
+	return t;
+}
+
+// -----------------------------------------------------------------------
+struct st * compose_norm(struct emas_ctx *ctx, int type, int opcode, int reg, struct st *norm)
 {
-	struct st *op = st_int(type, opcode | reg | norm->val);
+	struct st *op = st_int(ctx, type, opcode | reg | norm->val);
 	struct st *data = NULL;
 	if (norm->args) {
-		data = st_arg(N_WORD, norm->args, NULL);
+		data = compose_data(ctx, N_WORD, norm->args);
 		norm->args = NULL;
 	}
-	st_drop(norm);
+	st_drop(ctx, norm);
 	return st_app(op, data);
 }
 
 // -----------------------------------------------------------------------
-struct st * compose_list(int type, struct st *list)
+struct st * compose_list(struct emas_ctx *ctx, int type, struct st *list)
+{
+	struct st *elems = list->args;
+
+	// list holder is not needed anymore
+	list->args = list->last = NULL;
+	st_drop(ctx, list);
+
+	return compose_data(ctx, type, elems);
+}
+
+// -----------------------------------------------------------------------
+// Check if an operator node with literal arguments can be folded
+// without an error (errors are left for the evaluation to report)
+static int foldable(struct st *t)
+{
+	struct st *arg1 = t->args;
+	struct st *arg2 = arg1->next;
+
+	if ((arg1->type != N_INT) && (arg1->type != N_FLO)) return 0;
+	if (arg2 && (arg2->type != N_INT) && (arg2->type != N_FLO)) return 0;
+
+	int flo = (arg1->type == N_FLO) || (arg2 && (arg2->type == N_FLO));
+
+	switch (t->type) {
+		case N_DIV:
+			return (arg2->type == N_FLO) ? (arg2->flo != 0.0) : (arg2->val != 0);
+		case N_REM:
+			return !flo && (arg2->val != 0);
+		case N_PLUS:
+		case N_MINUS:
+		case N_MUL:
+		case N_UMINUS:
+			return 1;
+		default:
+			return !flo;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Fold an operator node with integer literal arguments
+static int64_t fold_int(int type, int64_t a, int64_t b)
+{
+	switch (type) {
+		case N_PLUS: return a + b;
+		case N_MINUS: return a - b;
+		case N_MUL: return a * b;
+		case N_DIV: return a / b;
+		case N_REM: return a % b;
+		case N_AND: return a & b;
+		case N_XOR: return a ^ b;
+		case N_OR: return a | b;
+		case N_LSHIFT: return a << b;
+		case N_RSHIFT: return a >> b;
+		case N_SCALE: return a << (15-b);
+		case N_UMINUS: return -a;
+		case N_NEG: return ~a;
+		default:
+			assert(!"unknown foldable operator");
+			return 0;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Fold an operator node with float (or mixed) literal arguments
+static double fold_float(int type, double a, double b)
+{
+	switch (type) {
+		case N_PLUS: return a + b;
+		case N_MINUS: return a - b;
+		case N_MUL: return a * b;
+		case N_DIV: return a / b;
+		case N_UMINUS: return -a;
+		default:
+			assert(!"unknown foldable operator");
+			return 0;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Create an operator node, fold it right away if arguments are literals
+struct st * compose_expr(struct emas_ctx *ctx, int type, struct st *arg1, struct st *arg2)
 {
-	struct st *out = NULL;
-	struct st *l = list;
-	struct st *next;
-
-	while (l) {
-		next = l->next;
-		out = st_app(out, st_arg(type, l, NULL));
-		l->next = NULL;
-		l = next;
+	struct st *t = st_arg(ctx, type, arg1, arg2, NULL);
+
+	if (!t || !foldable(t)) {
+		return t;
 	}
 
-	return out;
+	if ((arg1->type == N_INT) && (!arg2 || (arg2->type == N_INT))) {
+		t->val = fold_int(type, arg1->val, arg2 ? arg2->val : 0);
+		t->type = N_INT;
+	} else {
+		double a = (arg1->type == N_FLO) ? arg1->flo : arg1->val;
+		double b = !arg2 ? 0.0 : (arg2->type == N_FLO) ? arg2->flo : arg2->val;
+		t->flo = fold_float(type, a, b);
+		t->type = N_FLO;
+	}
+
+	st_drop(ctx, t->args);
+	t->args = t->last = NULL;
+
+	return t;
 }
 
 // vim: tabstop=4 autoindent
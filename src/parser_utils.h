@@ -18,9 +18,12 @@
 #ifndef PARSER_UTILS_H
 #define PARSER_UTILS_H
 
-void yyerror(const char *s, ...);
-struct st * compose_norm(int type, int opcode, int reg, struct st *norm);
-struct st * compose_list(int type, struct st *list);
+#include "parser.h"
+
+void yyerror(YYLTYPE *lloc, void *scanner, struct emas_ctx *ctx, const char *s, ...);
+struct st * compose_norm(struct emas_ctx *ctx, int type, int opcode, int reg, struct st *norm);
+struct st * compose_list(struct emas_ctx *ctx, int type, struct st *list);
+struct st * compose_expr(struct emas_ctx *ctx, int type, struct st *arg1, struct st *arg2);
 
 #endif
 
@@ -30,40 +30,32 @@
 #include "dh.h"
 #include "st.h"
 #include "prog.h"
-#include "lexer_utils.h"
-
-struct dh_table *sym;
-struct st *program;
-struct st *entry;
-
-char aerr[MAX_ERRLEN+1];
-int aadebug;
-
-int ic;
-int cpu = CPU_DEFAULT;
-int ic_max = 32767;
+#include "expr.h"
+#include "encode.h"
+#include "ctx.h"
 
 struct eval_t eval_tab[] = {
 	[N_NONE]	=	{ "NONE",	eval_none },
 	[N_INT]		=	{ "INT",	eval_none },
 	[N_BLOB]	=	{ "BLOB",	eval_none },
+	[N_FILL]	=	{ "FILL",	eval_none },
 	[N_FLO]		=	{ "FLOAT",	eval_none },
-	[N_PLUS]	=	{ "+",		eval_2arg },
-	[N_MINUS]	=	{ "-",		eval_2arg },
-	[N_MUL]		=	{ "*",		eval_2arg },
-	[N_DIV]		=	{ "/",		eval_2arg },
-	[N_REM]		=	{ "%",		eval_2arg },
-	[N_AND]		=	{ "&",		eval_2arg },
-	[N_XOR]		=	{ "^",		eval_2arg },
-	[N_OR]		=	{ "|",		eval_2arg },
-	[N_LSHIFT]	=	{ "<<",		eval_2arg },
-	[N_RSHIFT]	=	{ ">>",		eval_2arg },
-	[N_SCALE]	=	{ "\\",		eval_2arg },
-	[N_UMINUS]	=	{ "- (unary)",	eval_1arg },
-	[N_NEG]		=	{ "~",		eval_1arg },
-	[N_WORD]	=	{ ".word",	eval_word },
-	[N_DWORD]	=	{ ".dword",	eval_multiword },
-	[N_FLOAT]	=	{ ".float",	eval_multiword },
+	[N_PLUS]	=	{ "+",		eval_expr },
+	[N_MINUS]	=	{ "-",		eval_expr },
+	[N_MUL]		=	{ "*",		eval_expr },
+	[N_DIV]		=	{ "/",		eval_expr },
+	[N_REM]		=	{ "%",		eval_expr },
+	[N_AND]		=	{ "&",		eval_expr },
+	[N_XOR]		=	{ "^",		eval_expr },
+	[N_OR]		=	{ "|",		eval_expr },
+	[N_LSHIFT]	=	{ "<<",		eval_expr },
+	[N_RSHIFT]	=	{ ">>",		eval_expr },
+	[N_SCALE]	=	{ "\\",		eval_expr },
+	[N_UMINUS]	=	{ "- (unary)",	eval_expr },
+	[N_NEG]		=	{ "~",		eval_expr },
+	[N_WORD]	=	{ ".word",	eval_data },
+	[N_DWORD]	=	{ ".dword",	eval_data },
+	[N_FLOAT]	=	{ ".float",	eval_data },
 	[N_RES]		=	{ ".res",	eval_res },
 	[N_ORG]		=	{ ".org",	eval_org },
 	[N_ASCII]	=	{ ".ascii",	eval_string },
@@ -76,8 +68,8 @@ struct eval_t eval_tab[] = {
 	[N_LABEL]	=	{ "LABEL",	eval_label },
 	[N_EQU]		=	{ ".equ",	eval_equ },
 	[N_CONST]	=	{ ".const",	eval_const },
-	[N_NAME]	=	{ "NAME",	eval_name },
-	[N_CURLOC]	=	{ ".",		eval_curloc },
+	[N_NAME]	=	{ "NAME",	eval_expr },
+	[N_CURLOC]	=	{ ".",		eval_expr },
 	[N_OP_X]	=	{ "OP MX16",eval_op_mx16 },
 	[N_OP_RN]	=	{ "OP RN",eval_op_noarg },
 	[N_OP_N]	=	{ "OP N",	eval_op_noarg },
@@ -93,45 +85,48 @@ struct eval_t eval_tab[] = {
 	[N_OP_HLT]	=	{ "HLT",	eval_op_short },
 	[N_PROG]	=	{ "PROG",	eval_err },
 	[N_NORM]	=	{ "NORM",	eval_err },
+	[N_RELOC]	=	{ "RELOC",	eval_none },
 	[N_MAX]		=	{ "(max)",	eval_err }
 };
 
 // -----------------------------------------------------------------------
-void AADEBUG(char *format, ...)
+void AADEBUG(struct emas_ctx *ctx, char *format, ...)
 {
-	if (!aadebug) return;
-	fprintf(stderr, "DEBUG: ");
+	if (!ctx->aadebug) return;
+	fprintf(ctx->errf, "DEBUG: ");
 	va_list ap;
 	va_start(ap, format);
-	vfprintf(stderr, format, ap);
-	fprintf(stderr, "\n");
+	vfprintf(ctx->errf, format, ap);
+	fprintf(ctx->errf, "\n");
 	va_end(ap);
 }
 
 // -----------------------------------------------------------------------
-void aaerror(struct st *t, char *format, ...)
+void aaerror(struct emas_ctx *ctx, struct st *t, char *format, ...)
 {
 	va_list ap;
 	int len = 0;
 
 	if (t) {
-		len = snprintf(aerr, MAX_ERRLEN, "%s:%d:%d: ", t->loc_file, t->loc_line, t->loc_col);
+		struct st_loc *l = st_loc(ctx, t);
+		len = snprintf(ctx->aerr, MAX_ERRLEN, "%s:%d:%d: ", l->file, l->line, l->col);
 	}
 
 	if (len<MAX_ERRLEN) {
 		va_start(ap, format);
-		vsnprintf(aerr+len, MAX_ERRLEN-len, format, ap);
+		vsnprintf(ctx->aerr+len, MAX_ERRLEN-len, format, ap);
 		va_end(ap);
 	}
-	AADEBUG("Error logged: %s", aerr);
+	AADEBUG(ctx, "Error logged: %s", ctx->aerr);
 }
 
 // -----------------------------------------------------------------------
 struct st * int2float(struct st *t)
 {
 	if (t->type == N_INT) {
+		double flo = t->val;
 		t->type = N_FLO;
-		t->flo = t->val;
+		t->flo = flo;
 	}
 	return t;
 }
@@ -140,367 +135,225 @@ struct st * int2float(struct st *t)
 struct st * float2int(struct st *t)
 {
 	if (t->type == N_FLO) {
+		int64_t val = t->flo;
 		t->type = N_INT;
-		t->val = t->flo;
+		t->val = val;
 	}
 	return t;
 }
 
 // -----------------------------------------------------------------------
-int prog_cpu(char *cpu_name, int force)
+int cpu_by_name(char *cpu_name)
 {
 	assert(cpu_name);
 
-	// if cpu type was set in commandline, silently ignore .cpu directive
-	if (cpu & CPU_FORCED) {
-		return 0;
-	}
-
-	// if cpu type was already set using .cpu directive, fail
-	if (cpu != CPU_DEFAULT) {
-		return -1;
-	}
-
-	// first time setting cpu type
 	if (!strcasecmp(cpu_name, "mera400")) {
-		cpu = CPU_MERA400 | force;
-		ic_max = 32767;
+		return CPU_MERA400;
 	} else if (!strcasecmp(cpu_name, "mx16")) {
-		cpu = CPU_MX16 | force;
-		ic_max = 65535;
+		return CPU_MX16;
 	} else { // unknown CPU type
-		return 1;
+		return CPU_DEFAULT;
 	}
-
-	return 0;
-}
-
-// -----------------------------------------------------------------------
-int eval_1arg_int(struct st *t, struct st *arg)
-{
-	switch (t->type) {
-		case N_UMINUS:
-			t->val = -arg->val;
-			break;
-		case N_NEG:
-			t->val = ~arg->val;
-			break;
-		default:
-			assert(!"unknown 1-arg operator node");
-			return -1;
-	}
-
-	AADEBUG("%s %lli = %lli", eval_tab[t->type].name, (long long) arg->val, (long long) t->val);
-
-	t->type = N_INT;
-	t->flags |= arg->flags & ST_RELATIVE;
-
-	return 0;
 }
 
 // -----------------------------------------------------------------------
-int eval_1arg_float(struct st *t, struct st *arg)
+int prog_cpu(struct emas_ctx *ctx, int cpu, int force)
 {
-	switch (t->type) {
-		case N_UMINUS:
-			t->flo = -arg->flo;
-			break;
-		default:
-			aaerror(t, "Illegal operator for float number: %s", eval_tab[t->type].name);
-			return -1;
+	// if cpu type was set in commandline, silently ignore .cpu directive
+	if (ctx->cpu & CPU_FORCED) {
+		return 0;
 	}
 
-	AADEBUG("%s %f = %f", eval_tab[t->type].name, arg->flo, t->flo);
-
-	t->type = N_FLO;
-
-	return 0;
-}
-
-// -----------------------------------------------------------------------
-int eval_1arg(struct st *t)
-{
-	int u;
-	struct st *arg = t->args;
-
-	u = eval(arg);
-	if (u) return u;
-
-	if (arg->type == N_INT) {
-		u = eval_1arg_int(t, arg);
-		if (u) return u;
-	} else if (arg->type == N_FLO) {
-		u = eval_1arg_float(t, arg);
-		if (u) return u;
-	} else {
-		assert(!"not int nor float for 1arg eval");
+	// if cpu type was already set using .cpu directive, fail
+	if (ctx->cpu != CPU_DEFAULT) {
 		return -1;
 	}
 
-	st_drop(arg);
-	t->args = t->last = NULL;
-
-	return 0;
-}
-
-// -----------------------------------------------------------------------
-int eval_2arg_int(struct st *t, struct st *arg1, struct st *arg2)
-{
-	if ((t->type == N_MINUS) && (arg1->flags & ST_RELATIVE) && (arg2->flags & ST_RELATIVE)) {
-		t->flags &= ~ST_RELATIVE;
-	} else {
-		t->flags |= (arg1->flags | arg2->flags) & ST_RELATIVE;
-	}
-
-	switch (t->type) {
-		case N_PLUS:
-			t->val = arg1->val + arg2->val;
-			break;
-		case N_MINUS:
-			t->val = arg1->val - arg2->val;
-			break;
-		case N_MUL:
-			t->val = arg1->val * arg2->val;
-			break;
-		case N_DIV:
-			if (arg2->val == 0) {
-				aaerror(t, "Division by 0");
-				return -1;
-			}
-			t->val = arg1->val / arg2->val;
-			break;
-		case N_REM:
-			if (arg2->val == 0) {
-				aaerror(t, "Division by 0");
-				return -1;
-			}
-			t->val = arg1->val % arg2->val;
-			break;
-		case N_AND:
-			t->val = arg1->val & arg2->val;
-			break;
-		case N_XOR:
-			t->val = arg1->val ^ arg2->val;
-			break;
-		case N_OR:
-			t->val = arg1->val | arg2->val;
-			break;
-		case N_LSHIFT:
-			t->val = arg1->val << arg2->val;
-			break;
-		case N_RSHIFT:
-			t->val = arg1->val >> arg2->val;
+	// first time setting cpu type
+	switch (cpu) {
+		case CPU_MERA400:
+			ctx->ic_max = 32767;
 			break;
-		case N_SCALE:
-			t->val = arg1->val << (15-arg2->val);
+		case CPU_MX16:
+			ctx->ic_max = 65535;
 			break;
-		default:
-			assert(!"unknown 2-arg operator");
-			return -1;
+		default: // unknown CPU type
+			return 1;
 	}
 
-	t->type = N_INT;
-	st_drop(t->args);
-	t->args = t->last = NULL;
-
-	AADEBUG("%lli %s %lli = %lli", (long long) arg1->val, eval_tab[t->type].name, (long long) arg2->val, (long long) t->val);
+	ctx->cpu = cpu | force;
 
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int eval_2arg_float(struct st *t, struct st *arg1, struct st *arg2)
+// Check if a value can be used where the linker has no way to relocate it
+// (module-relative values are fine only if 'relative_ok' is set)
+static int reloc_check(struct emas_ctx *ctx, struct st *t, int relative_ok)
 {
-	if ((t->type == N_MINUS) && (arg1->flags & ST_RELATIVE) && (arg2->flags & ST_RELATIVE)) {
-		t->flags &= ~ST_RELATIVE;
-	} else {
-		t->flags |= (arg1->flags | arg2->flags) & ST_RELATIVE;
-	}
-
-	switch (t->type) {
-		case N_PLUS:
-			t->flo = arg1->flo + arg2->flo;
-			break;
-		case N_MINUS:
-			t->flo = arg1->flo - arg2->flo;
-			break;
-		case N_MUL:
-			t->flo = arg1->flo * arg2->flo;
-			break;
-		case N_DIV:
-			if (arg2->flo == 0.0) {
-				aaerror(t, "Division by 0");
-				return -1;
-			}
-			t->flo = arg1->flo / arg2->flo;
-			break;
-		default:
-			aaerror(t, "Illegal operator for float numbers: %s", eval_tab[t->type].name);
-			return -1;
+	if (!ctx->relocatable) {
+		return 0;
 	}
 
-	AADEBUG("%f %s %f = %f", arg1->flo, eval_tab[t->type].name, arg2->flo, t->flo);
-
-	t->type = N_FLO;
-
-	return 0;
-}
-
-// -----------------------------------------------------------------------
-int eval_2arg(struct st *t)
-{
-	int u1, u2;
-	struct st *arg1 = t->args;
-	struct st *arg2 = t->args->next;
-
-	u1 = eval(arg1);
-	if (u1 < 0) return u1;
-
-	u2 = eval(arg2);
-	if (u2 < 0) return u2;
-
-	if (u1 || u2) return 1;
-
-	if ((arg1->type == N_INT) && (arg2->type == N_INT)) {
-		u1 = eval_2arg_int(t, arg1, arg2);
-		if (u1) return u1;
-	} else if ((arg1->type == N_FLO) || (arg2->type == N_FLO)) {
-		u1 = eval_2arg_float(t, int2float(arg1), int2float(arg2));
-		if (u1) return u1;
-	} else {
-		assert(!"not int nor float for 2arg eval");
+	if ((t->flags & ST_EXTERN) || ((t->flags & ST_RELATIVE) && !relative_ok)) {
+		aaerror(ctx, t, "Value cannot be relocated");
 		return -1;
 	}
 
-	st_drop(t->args);
-	t->args = t->last = NULL;
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int render_float(struct st *t)
+// Get size of a single data run element
+int data_elem_size(int type)
 {
-	uint16_t regs[4]; // r0...r3, flags stored in r0
-	int res = awp_from_double(regs, t->flo);
-	if (!t->data) {
-		t->data = malloc(3 * sizeof(uint16_t));
-	}
-	memcpy(t->data, regs+1, 3 * sizeof(uint16_t));
-
-	// check for overflow/underflow
-	switch (res) {
-		case AWP_FP_OF:
-			aaerror(t, "Floating point overflow");
-			return -1;
-		case AWP_FP_UF:
-			aaerror(t, "Floating point underflow");
-			return -1;
+	switch (type) {
+		case N_DWORD:
+			return 2;
+		case N_FLOAT:
+			return 3;
+		default:
+			return 1;
 	}
-
-	return 0;
 }
 
 // -----------------------------------------------------------------------
-int eval_word(struct st *t)
+// Encode value of the data run element into the run buffer (at the element
+// offset). Errors are logged only if 'report' is set, so literals can be
+// tried at parse time and left for the evaluation to report.
+int data_put(struct emas_ctx *ctx, struct st *t, struct st *e, int report)
 {
-	int u;
-
-	t->size = 1;
-
-	u = eval(t->args);
-	if (u) return u;
-	float2int(t->args);
+	uint16_t *d = t->data + e->ic;
+	uint16_t regs[4]; // r0...r3, flags stored in r0
 
 	switch (t->type) {
 		case N_WORD:
-			if ((t->args->val < SHRT_MIN) || (t->args->val > USHRT_MAX)) {
-				aaerror(t, "Value %lli is not an 16-bit signed/unsigned integer", (long long) t->args->val);
+			float2int(e);
+			if ((e->val < SHRT_MIN) || (e->val > USHRT_MAX)) {
+				if (report) aaerror(ctx, t, "Value %lli is not an 16-bit signed/unsigned integer", (long long) e->val);
 				return -1;
 			}
-			t->val = t->args->val;
+			d[0] = e->val;
+			// writers show the value the way it was given
+			uint16_t *signs = t->data + t->size + e->ic / 16;
+			if (e->val < 0) {
+				*signs |= 1 << (e->ic % 16);
+			} else {
+				*signs &= ~(1 << (e->ic % 16));
+			}
 			break;
-	}
-
-	t->type = N_INT;
-	t->flags |= t->args->flags & ST_RELATIVE;
-	st_drop(t->args);
-	t->args = t->last = NULL;
-
-	return 0;
-}
-
-// -----------------------------------------------------------------------
-int eval_multiword(struct st *t)
-{
-	int u;
-	struct st *arg = t->args;
-
-	switch (t->type) {
 		case N_DWORD:
-			t->size = 2;
+			float2int(e);
+			if ((e->val < INT_MIN) || (e->val > UINT_MAX)) {
+				if (report) aaerror(ctx, t, "Value won't fit in a DWORD: %lli", (long long) e->val);
+				return -1;
+			}
+			d[0] = e->val >> 16;
+			d[1] = e->val & 65535;
 			break;
 		case N_FLOAT:
-			t->size = 3;
+			// check for overflow/underflow
+			switch (awp_from_double(regs, int2float(e)->flo)) {
+				case AWP_FP_OF:
+					if (report) aaerror(ctx, e, "Floating point overflow");
+					return -1;
+				case AWP_FP_UF:
+					if (report) aaerror(ctx, e, "Floating point underflow");
+					return -1;
+			}
+			memcpy(d, regs+1, 3 * sizeof(uint16_t));
 			break;
 		default:
-			assert(!"not a multiword");
+			assert(!"not a data run");
 			break;
 	}
 
-	if ((t->size < 0) || (t->size > 65536)) {
-		aaerror(t, "Cannot fit the array in a process address space (%i words needed)", t->size);
-		return -1;
-	}
+	return 0;
+}
 
-	if (!t->data) {
-		t->data = malloc(t->size * sizeof(uint16_t));
+// -----------------------------------------------------------------------
+// Encode data run elements that were not known at parse time.
+// In relocatable modules, words that need to be relocated are encoded
+// with their addend and stay on the argument list as N_RELOC nodes.
+int eval_data(struct emas_ctx *ctx, struct st *t)
+{
+	char aerr[MAX_ERRLEN+1];
+	struct dh_elem *unresolved = NULL;
+	struct st *e = t->args;
+	struct st *prev = NULL;
+	int ic = ctx->ic;
+	int res = 0;
+
+	while (e) {
+		struct st *next = e->next;
+		if (e->type == N_RELOC) {
+			prev = e;
+			e = next;
+			continue;
+		}
+		ctx->ic = ic + e->ic;
+		int u = eval(ctx, e);
+		int reloc = !u && (e->flags & (ST_RELATIVE | ST_EXTERN)) && ctx->relocatable;
+		if (reloc && (t->type != N_WORD)) {
+			u = reloc_check(ctx, e, 0);
+		}
+		if (!u) {
+			u = data_put(ctx, t, e, 1);
+		}
+		if (u < 0) {
+			ctx->ic = ic;
+			return u;
+		} else if (u > 0) {
+			// the run waits for the first unresolved element
+			if (!res) {
+				res = u;
+				unresolved = ctx->unresolved;
+				strcpy(aerr, ctx->aerr);
+			}
+			prev = e;
+		} else if (reloc) {
+			e->type = N_RELOC;
+			prev = e;
+		} else {
+			// element is encoded, it is not needed anymore
+			if (prev) {
+				prev->next = next;
+			} else {
+				t->args = next;
+			}
+			e->next = NULL;
+			st_drop(ctx, e);
+		}
+		e = next;
 	}
 
-	u = eval(arg);
-	if (u) return u;
+	ctx->ic = ic;
+	t->last = prev;
 
-	switch (t->type) {
-		case N_DWORD:
-			float2int(arg);
-			if ((arg->val < INT_MIN) || (arg->val > UINT_MAX)) {
-				aaerror(t, "Value won't fit in a DWORD: %lli", (long long) arg->val);
-				return -1;
-			}
-			t->data[0] = arg->val >> 16;
-			t->data[1] = arg->val & 65535;
-			break;
-		case N_FLOAT:
-			u = render_float(int2float(arg));
-			if (u) return u;
-			t->data[0] = arg->data[0];
-			t->data[1] = arg->data[1];
-			t->data[2] = arg->data[2];
-			break;
-		default:
-			assert(!"not a multiword");
-			break;
+	if (res) {
+		ctx->unresolved = unresolved;
+		strcpy(ctx->aerr, aerr);
+		return res;
 	}
 
 	t->type = N_BLOB;
-	st_drop(t->args);
-	t->args = t->last = NULL;
 
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int eval_res(struct st *t)
+int eval_res(struct emas_ctx *ctx, struct st *t)
 {
 	int u;
 	int value = 0;
 
 	// first, we need element count
-	u = eval(t->args);
-	if (u) return -1;
+	u = eval(ctx, t->args);
+	if (u || reloc_check(ctx, t->args, 0)) return -1;
 	float2int(t->args);
 
 	if ((t->args->val < 0) || (t->args->val > 65536)) {
-		aaerror(t, "Cannot reserve memory outside the process address space (requested %lli words)", (long long) t->args->val);
+		aaerror(ctx, t, "Cannot reserve memory outside the process address space (requested %lli words)", (long long) t->args->val);
 		return -1;
 	}
 
@@ -508,45 +361,43 @@ int eval_res(struct st *t)
 
 	// then, check if user specified a value to fill with
 	if (t->args->next) {
-		u = eval(t->args->next);
+		u = eval(ctx, t->args->next);
 		if (u) return u;
+		if (reloc_check(ctx, t->args->next, 0)) return -1;
 		float2int(t->args->next);
 		value = t->args->next->val;
 	}
 
-	if (!t->data) {
-		t->data = malloc(t->size * sizeof(uint16_t));
-		for (int i=0 ; i<t->size ; i++) t->data[i] = value;
-	}
-
-	t->type = N_BLOB;
-	st_drop(t->args);
+	// reserved memory is not rendered here, writers take care of it
+	t->val = (uint16_t) value;
+	t->type = N_FILL;
+	st_drop(ctx, t->args);
 	t->args = t->last = NULL;
 
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int eval_org(struct st *t)
+int eval_org(struct emas_ctx *ctx, struct st *t)
 {
-	int u = eval(t->args);
-	if (u) return -1;
+	int u = eval(ctx, t->args);
+	if (u || reloc_check(ctx, t->args, 1)) return -1;
 	float2int(t->args);
 
-	if (t->args->val < ic) {
-		aaerror(t, "Cannot move location pointer backwards by %lli words", (long long) t->args->val - ic);
+	if (t->args->val < ctx->ic) {
+		aaerror(ctx, t, "Cannot move location pointer backwards by %lli words", (long long) t->args->val - ctx->ic);
 		return -1;
 	}
-	ic = t->args->val;
+	ctx->ic = t->args->val;
 	t->type = N_NONE;
-	st_drop(t->args);
+	st_drop(ctx, t->args);
 	t->args = t->last = NULL;
 
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int eval_string(struct st *t)
+int eval_string(struct emas_ctx *ctx, struct st *t)
 {
 	char *s = t->str;
 	int chars, words;
@@ -557,11 +408,11 @@ int eval_string(struct st *t)
 	words = (chars+1) / 2;
 
 	if ((words < 0) || (words > 65536)) {
-		aaerror(t, "Cannot fit the string in a process address space (%i words needed)", words);
+		aaerror(ctx, t, "Cannot fit the string in a process address space (%i words needed)", words);
 		return -1;
 	}
 
-	t->data = malloc(words * sizeof(uint16_t));
+	t->data = arena_alloc(&ctx->arena, words * sizeof(uint16_t));
 	t->size = 0;
 	t->type = N_BLOB;
 
@@ -587,26 +438,175 @@ int eval_string(struct st *t)
 }
 
 // -----------------------------------------------------------------------
-int eval_label(struct st *t)
+// Find (or create, as a placeholder) symbol table entry of the global label
+// a local name belongs to
+static struct dh_elem * sym_parent(struct emas_ctx *ctx, char *name, char *dot, int create)
+{
+	char buf[STR_MAX+1];
+	char *label = buf;
+
+	int len = dot - name;
+	if (len > STR_MAX) {
+		label = malloc(len+1);
+		if (!label) {
+			return NULL;
+		}
+	}
+	memcpy(label, name, len);
+	label[len] = '\0';
+
+	struct dh_elem *s = dh_get(ctx->sym, label);
+	if (!s && create) {
+		s = dh_addv(ctx->sym, label, SYM_UNDEFINED | SYM_PLACEHOLDER, 0);
+	}
+
+	if (label != buf) {
+		free(label);
+	}
+
+	return s;
+}
+
+// -----------------------------------------------------------------------
+// Get the table a symbol belongs to (name is an atom). Local names
+// ("label.local") live in a small table owned by their global label,
+// keyed by the local part. Atom of a local name keeps the label entry,
+// so only the first lookup goes through the global table.
+// Label entry and its table are created (label as a placeholder)
+// if 'create' is set, otherwise NULL is returned if there are none.
+static struct dh_table * sym_table(struct emas_ctx *ctx, char *name, int create)
+{
+	struct dh_elem *a = dh_elem_of(name);
+
+	if (!a->parent) {
+		char *dot = strchr(name, '.');
+		if (!dot) {
+			return ctx->sym;
+		}
+		a->parent = sym_parent(ctx, name, dot, create);
+		if (!a->parent) {
+			return NULL;
+		}
+	}
+
+	struct dh_elem *s = a->parent;
+	if (!s->locals && create) {
+		s->locals = dh_create(16, ctx->sym->case_sens);
+		if (s->locals) { // all names there start with the label
+			s->locals->key_offset = strlen(s->name);
+		}
+	}
+
+	return s->locals;
+}
+
+// -----------------------------------------------------------------------
+// Drop all symbols. Atoms of local names forget their labels too.
+void sym_clear(struct emas_ctx *ctx)
+{
+	dh_clear(ctx->sym);
+
+	for (unsigned i=0 ; i<ctx->atoms->size ; i++) {
+		struct dh_elem *a = ctx->atoms->slots[i].elem;
+		if (a) {
+			a->parent = NULL;
+		}
+	}
+}
+
+// -----------------------------------------------------------------------
+// Get symbol definition (entries only referenced so far don't count)
+struct dh_elem * sym_get(struct emas_ctx *ctx, char *name)
+{
+	struct dh_table *dh = sym_table(ctx, name, 0);
+	struct dh_elem *s = dh ? dh_get(dh, name) : NULL;
+
+	if (s && (s->type & SYM_PLACEHOLDER)) {
+		return NULL;
+	}
+
+	return s;
+}
+
+// -----------------------------------------------------------------------
+// Define a new symbol. If the name has already been referenced,
+// the placeholder entry (that references are bound to) is filled in.
+struct dh_elem * sym_add(struct emas_ctx *ctx, char *name, int type, struct st *t)
+{
+	struct dh_table *dh = sym_table(ctx, name, 1);
+	if (!dh) {
+		return NULL;
+	}
+
+	struct dh_elem *s = dh_get(dh, name);
+
+	if (!s) {
+		return dh_addt(dh, name, type, t);
+	}
+
+	s->type = type;
+	s->value = 0;
+	s->t = t;
+
+	return s;
+}
+
+// -----------------------------------------------------------------------
+// Get symbol table entry for a name reference, create a placeholder
+// if the symbol is not there yet
+struct dh_elem * sym_ref(struct emas_ctx *ctx, char *name)
+{
+	struct dh_table *dh = sym_table(ctx, name, 1);
+	if (!dh) {
+		return NULL;
+	}
+
+	struct dh_elem *s = dh_get(dh, name);
+
+	if (!s) {
+		s = dh_addv(dh, name, SYM_UNDEFINED | SYM_PLACEHOLDER, 0);
+	}
+
+	return s;
+}
+
+// -----------------------------------------------------------------------
+// Bind all name references in the tree to their symbol table entries,
+// so evaluation does not need to look them up again
+void bind_names(struct emas_ctx *ctx, struct st *t)
+{
+	while (t) {
+		if (t->type == N_NAME) {
+			t->sym = sym_ref(ctx, t->str);
+		}
+		bind_names(ctx, t->args);
+		t = t->next;
+	}
+}
+
+// -----------------------------------------------------------------------
+int eval_label(struct emas_ctx *ctx, struct st *t)
 {
 	struct dh_elem *s;
 	struct st *tic;
 
-	s = dh_get(sym, t->str);
+	s = sym_get(ctx, t->str);
 
 	if (!s) {
-		tic = st_int(N_INT, ic);
+		tic = st_int(ctx, N_INT, ctx->ic);
 		tic->flags |= ST_RELATIVE;
-		dh_addt(sym, t->str, SYM_CONST, tic);
+		tic->loc = t->loc;
+		sym_add(ctx, t->str, SYM_CONST, tic);
 	} else if (s->type & SYM_UNDEFINED) {
 		// this is when .global label appears before label
 		s->type &= ~SYM_UNDEFINED;
 		s->type |= SYM_CONST;
-		tic = st_int(N_INT, ic);
+		tic = st_int(ctx, N_INT, ctx->ic);
 		tic->flags |= ST_RELATIVE;
+		tic->loc = t->loc;
 		s->t = tic;
 	} else {
-		aaerror(t, "Symbol '%s' already defined", t->str);
+		aaerror(ctx, t, "Symbol '%s' already defined", t->str);
 		return -1;
 	}
 
@@ -616,26 +616,28 @@ int eval_label(struct st *t)
 }
 
 // -----------------------------------------------------------------------
-int eval_equ(struct st *t)
+int eval_equ(struct emas_ctx *ctx, struct st *t)
 {
 	int u;
 	struct dh_elem *s;
 
-	u = eval(t->args);
+	u = eval(ctx, t->args);
 	if (u < 0) return u;
 
-	s = dh_get(sym, t->str);
+	// symbol is defined at this statement (errors still point at the value)
+	st_loc_stmt(ctx, t->args, t);
+	s = sym_get(ctx, t->str);
 
 	if (!s) {
-		dh_addt(sym, t->str, 0, t->args);
+		sym_add(ctx, t->str, 0, t->args);
 	} else if (s->type & SYM_CONST) { // defined, but constant
-		aaerror(t, "Const symbol '%s' cannot be redefined", t->str);
+		aaerror(ctx, t, "Const symbol '%s' cannot be redefined", t->str);
 		return -1;
 	} else if (s->type & SYM_UNDEFINED) { // is there, but undefined
 		s->type &= ~SYM_UNDEFINED;
 		s->t = t->args;
 	} else { // defined, variable - just redefine
-		st_drop(s->t);
+		st_drop(ctx, s->t);
 		s->t = t->args;
 	}
 
@@ -646,23 +648,25 @@ int eval_equ(struct st *t)
 }
 
 // -----------------------------------------------------------------------
-int eval_const(struct st *t)
+int eval_const(struct emas_ctx *ctx, struct st *t)
 {
 	int u;
 	struct dh_elem *s;
 
-	u = eval(t->args);
+	u = eval(ctx, t->args);
 	if (u < 0) return u;
 
-	s = dh_get(sym, t->str);
+	// symbol is defined at this statement (errors still point at the value)
+	st_loc_stmt(ctx, t->args, t);
+	s = sym_get(ctx, t->str);
 
 	if (!s) {
-		dh_addt(sym, t->str, SYM_CONST, t->args);
+		sym_add(ctx, t->str, SYM_CONST, t->args);
 	} else if (s->type & SYM_UNDEFINED) { // is there, but undefined
 		s->type &= ~SYM_UNDEFINED;
 		s->t = t->args;
 	} else {
-		aaerror(t, "Symbol '%s' already defined", t->str);
+		aaerror(ctx, t, "Symbol '%s' already defined", t->str);
 		return -1;
 	}
 
@@ -672,14 +676,25 @@ int eval_const(struct st *t)
 	return 0;}
 
 // -----------------------------------------------------------------------
-int eval_entry(struct st *t)
+// Entry point is evaluated here, so writers get its value
+int eval_entry(struct emas_ctx *ctx, struct st *t)
 {
-	if (entry) {
-		aaerror(t, "Program entry already defined");
+	if (ctx->entry && (ctx->entry != t->args)) {
+		aaerror(ctx, t, "Program entry already defined");
 		return -1;
 	}
 
-	entry = t->args;
+	ctx->entry = t->args;
+
+	int u = eval(ctx, t->args);
+	if (u) return u;
+	if (reloc_check(ctx, t->args, 1)) return -1;
+	float2int(t->args);
+
+	if ((t->args->val < 0) || (t->args->val > ctx->ic_max)) {
+		aaerror(ctx, t, "Program entry outside the process address space: %lli", (long long) t->args->val);
+		return -1;
+	}
 
 	t->type = N_NONE;
 	t->args = NULL;
@@ -688,16 +703,16 @@ int eval_entry(struct st *t)
 }
 
 // -----------------------------------------------------------------------
-int eval_global(struct st *t)
+int eval_global(struct emas_ctx *ctx, struct st *t)
 {
 	struct dh_elem *s;
 
-	s = dh_get(sym, t->str);
+	s = sym_get(ctx, t->str);
 
 	if (s) {
 		s->type |= SYM_GLOBAL;
 	} else {
-		dh_addv(sym, t->str, SYM_UNDEFINED | SYM_GLOBAL, 0);
+		sym_add(ctx, t->str, SYM_UNDEFINED | SYM_GLOBAL, NULL);
 	}
 
 	t->type = N_NONE;
@@ -706,10 +721,10 @@ int eval_global(struct st *t)
 }
 
 // -----------------------------------------------------------------------
-int eval_ifdef(struct st *t)
+int eval_ifdef(struct emas_ctx *ctx, struct st *t)
 {
 	struct st *prog;
-	struct dh_elem *s = dh_get(sym, t->str);
+	struct dh_elem *s = sym_get(ctx, t->str);
 
 	if (s && !(s->type & SYM_UNDEFINED)) {
 		// first argument holds the program block for 'symbol defined' case
@@ -738,117 +753,80 @@ int eval_ifdef(struct st *t)
 }
 
 // -----------------------------------------------------------------------
-int eval_struct(struct st *t)
+// Update struct field offset, if offset and size of the previous field is known
+static void struct_field_offset(struct emas_ctx *ctx, struct st *t, struct st *prev)
 {
 	struct dh_elem *s;
 
-	s = dh_get(sym, t->str);
+	s = sym_get(ctx, t->str);
 	if (!s) {
-		s = dh_addt(sym, t->str, SYM_CONST | SYM_UNDEFINED, st_int(N_INT, 0));
-	}
-
-	// evaluate all arguments (struct fields)
-	struct st *args = t->args;
-	while (args) {
-		int u = eval(args);
-		if (u) return u;
-		args = args->next;
+		s = sym_add(ctx, t->str, SYM_CONST | SYM_UNDEFINED, st_int(ctx, N_INT, 0));
 	}
 
-	// update structure size only when all field sizes are known
-	s->t->val = t->last->val + t->last->args->val;
-	s->type &= ~SYM_UNDEFINED;
-
-	// drop the arguments subtree
-	t->type = N_NONE;
-	st_drop(t->args);
-	t->args = t->last = NULL;
-
-	return 0;
-}
-
-// -----------------------------------------------------------------------
-int eval_struct_field(struct st *t)
-{
-	int u;
-	struct dh_elem *s;
-
-	s = dh_get(sym, t->str);
-	if (!s) {
-		s = dh_addt(sym, t->str, SYM_CONST | SYM_UNDEFINED, st_int(N_INT, 0));
-	}
-
-	if (!t->prev) { // offset for the first element is always known = 0
+	if (!prev) { // offset for the first element is always known = 0
 		t->val = 0;
 		s->t->val = t->val;
 		s->type &= ~SYM_UNDEFINED;
 	} else { // if this is not the first element
-		if (t->prev->args->type == N_INT) { // size of the previous field is known
-			struct dh_elem *ps = dh_get(sym, t->prev->str); // get the offset
+		if (prev->args->type == N_INT) { // size of the previous field is known
+			struct dh_elem *ps = sym_get(ctx, prev->str); // get the offset
 			if (!(ps->type & SYM_UNDEFINED)) { // offset of the previous field is known
-				t->val = t->prev->args->val + t->prev->val; // update this element offset
+				t->val = prev->args->val + prev->val; // update this element offset
 				s->t->val = t->val; // update element in the dictionary
 				s->type &= ~SYM_UNDEFINED;
 			}
 		}
 	}
-
-	// evaluate size of this struct element
-	u = eval(t->args);
-
-	return u;
 }
 
 // -----------------------------------------------------------------------
-int eval_name(struct st *t)
+int eval_struct(struct emas_ctx *ctx, struct st *t)
 {
-	int u;
-	struct dh_elem *s = dh_get(sym, t->str);
+	struct dh_elem *s;
 
-	if (!s || (s->type & SYM_UNDEFINED)) {
-		aaerror(t, "Symbol '%s' not defined", t->str);
-		return 1;
+	s = sym_get(ctx, t->str);
+	if (!s) {
+		s = sym_add(ctx, t->str, SYM_CONST | SYM_UNDEFINED, st_int(ctx, N_INT, 0));
 	}
 
-	assert(s->t);
-
-	if (s->being_evaluated > 0) {
-		aaerror(t, "Symbol '%s' is defined recursively", t->str);
-		return 1;
+	// evaluate all arguments (struct fields)
+	struct st *args = t->args;
+	struct st *prev = NULL;
+	while (args) {
+		struct_field_offset(ctx, args, prev);
+		int u = eval(ctx, args);
+		if (u) return u;
+		prev = args;
+		args = args->next;
 	}
 
-	s->being_evaluated++;
-	u = eval(s->t);
-	if (u) {
-		s->being_evaluated--;
-		return u;
-	}
-	s->being_evaluated--;
+	// update structure size only when all field sizes are known
+	s->t->val = t->last->val + t->last->args->val;
+	s->type &= ~SYM_UNDEFINED;
 
-	t->type = s->t->type;
-	t->val = s->t->val;
-	t->flo = s->t->flo;
-	t->flags |= s->t->flags & ST_RELATIVE;
+	// drop the arguments subtree
+	t->type = N_NONE;
+	st_drop(ctx, t->args);
+	t->args = t->last = NULL;
 
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int eval_curloc(struct st *t)
+int eval_struct_field(struct emas_ctx *ctx, struct st *t)
 {
-	t->type = N_INT;
-	t->val = ic;
-	t->flags |= ST_RELATIVE;
-	return 0;
+	// evaluate size of this struct element
+	// (offset is updated by the structure, which knows the previous field)
+	return eval(ctx, t->args);
 }
 
 // -----------------------------------------------------------------------
-int eval_as_short(struct st *t, int type, int op)
+int eval_as_short(struct emas_ctx *ctx, struct st *t, int type, int op)
 {
 	int min, max;
 	int opl, rel_op = 0;
 
-	int u = eval(t);
+	int u = eval(ctx, t);
 	if (u) return u;
 	float2int(t);
 
@@ -880,8 +858,13 @@ int eval_as_short(struct st *t, int type, int op)
 			break;
 	}
 
+	// relative argument for relative instruction is a displacement
+	if (reloc_check(ctx, t, rel_op)) {
+		return -1;
+	}
+
 	if (rel_op && (t->flags & ST_RELATIVE)) {
-		int diff = t->val - (ic+1);
+		int diff = t->val - (ctx->ic+1);
 		// TODO: U WUT M8?
 		if (diff >= 65535 - 63) {
 			t->val = diff - 65536;
@@ -893,7 +876,7 @@ int eval_as_short(struct st *t, int type, int op)
 	}
 
 	if ((t->val < min) || (t->val > max)) {
-		aaerror(t, "Argument value %lli for %s is out of range (%i..%i)", (long long) t->val, eval_tab[t->type].name, min, max);
+		aaerror(ctx, t, "Argument value %lli for %s is out of range (%i..%i)", (long long) t->val, eval_tab[t->type].name, min, max);
 		return -1;
 	}
 
@@ -901,14 +884,14 @@ int eval_as_short(struct st *t, int type, int op)
 }
 
 // -----------------------------------------------------------------------
-int eval_op_short(struct st *t)
+int eval_op_short(struct emas_ctx *ctx, struct st *t)
 {
 	int u;
 	struct st *arg = t->args;
 
 	t->size = 1;
 
-	u = eval_as_short(arg, t->type, t->val);
+	u = eval_as_short(ctx, arg, t->type, t->val);
 	if (u) return u;
 
 	switch (t->type) {
@@ -932,7 +915,7 @@ int eval_op_short(struct st *t)
 		// TODO: BRC/BLC arguments need to be rethinked
 		case N_OP_BLC:
 			if (arg->val & ~0xff00) {
-				aaerror(t, "BLC argument may only have left byte bits set");
+				aaerror(ctx, t, "BLC argument may only have left byte bits set");
 				return -1;
 			}
 			arg->val = arg->val >> 8;
@@ -943,25 +926,25 @@ int eval_op_short(struct st *t)
 
 	t->type = N_INT;
 	t->val |= arg->val;
-	st_drop(arg);
+	st_drop(ctx, arg);
 	t->args = t->last = NULL;
 
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int eval_op_mx16(struct st *t)
+int eval_op_mx16(struct emas_ctx *ctx, struct st *t)
 {
-	if (!(cpu & CPU_MX16)) {
-		aaerror(t, "Instruction valid only for MX-16");
+	if (!(ctx->cpu & CPU_MX16)) {
+		aaerror(ctx, t, "Instruction valid only for MX-16");
 		return -1;
 	} else {
-		return eval_op_noarg(t);
+		return eval_op_noarg(ctx, t);
 	}
 }
 
 // -----------------------------------------------------------------------
-int eval_op_noarg(struct st *t)
+int eval_op_noarg(struct emas_ctx *ctx, struct st *t)
 {
 	t->type = N_INT;
 	t->size = 1;
@@ -970,77 +953,387 @@ int eval_op_noarg(struct st *t)
 }
 
 // -----------------------------------------------------------------------
-int eval_none(struct st *t)
+int eval_none(struct emas_ctx *ctx, struct st *t)
 {
 	return 0;
 }
 
 // -----------------------------------------------------------------------
-int eval_err(struct st *t)
+int eval_err(struct emas_ctx *ctx, struct st *t)
 {
-	aaerror(t, "Cannot eval node type %i", t->type);
+	aaerror(ctx, t, "Cannot eval node type %i", t->type);
 	return -1;
 }
 
 // -----------------------------------------------------------------------
-int eval(struct st *t)
+int eval(struct emas_ctx *ctx, struct st *t)
 {
 	if ((t->type >= N_MAX) || (t->type < 0)) {
-		return eval_err(t);
+		return eval_err(ctx, t);
+	}
+
+	AADEBUG(ctx, " eval: %s", eval_tab[t->type].name);
+
+	return eval_tab[t->type].fun(ctx, t);
+}
+
+// -----------------------------------------------------------------------
+// Append a top-level statement to the program statement array
+static int stmt_add(struct emas_ctx *ctx, struct st *t)
+{
+	if (ctx->stmt_count >= ctx->stmt_cap) {
+		int cap = ctx->stmt_cap ? ctx->stmt_cap * 2 : 256;
+		struct st **s = realloc(ctx->stmts, cap * sizeof(struct st*));
+		if (!s) {
+			aaerror(ctx, t, "Cannot allocate memory for the statement array");
+			return -1;
+		}
+		ctx->stmts = s;
+		ctx->stmt_cap = cap;
+	}
+
+	ctx->stmts[ctx->stmt_count++] = t;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Remember a node that needs to be evaluated again once symbols
+// it depends on are defined
+static int fixup_add(struct emas_ctx *ctx, struct st *t)
+{
+	if (ctx->fixup_count >= ctx->fixup_cap) {
+		int cap = ctx->fixup_cap ? ctx->fixup_cap * 2 : 256;
+		struct fixup *f = realloc(ctx->fixups, cap * sizeof(struct fixup));
+		if (!f) {
+			aaerror(ctx, t, "Cannot allocate memory for the fixup list");
+			return -1;
+		}
+		ctx->fixups = f;
+		ctx->fixup_cap = cap;
 	}
 
-	AADEBUG(" eval: %s", eval_tab[t->type].name);
+	ctx->fixups[ctx->fixup_count].t = t;
+	ctx->fixups[ctx->fixup_count].wait = ctx->unresolved;
+	ctx->fixup_count++;
 
-	return eval_tab[t->type].fun(t);
+	return 0;
 }
 
 // -----------------------------------------------------------------------
-int assemble(struct st *prog, int keep_going)
+// Find a pending structure that defines the symbol
+static struct fixup * fixup_definer(struct emas_ctx *ctx, struct dh_elem *s)
+{
+	for (int i=0 ; i<ctx->fixup_count ; i++) {
+		struct st *t = ctx->fixups[i].t;
+		if (t->type != N_STRUCT) continue;
+		if (sym_get(ctx, t->str) == s) {
+			return ctx->fixups + i;
+		}
+		for (struct st *field=t->args ; field ; field=field->next) {
+			if (sym_get(ctx, field->str) == s) {
+				return ctx->fixups + i;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+// -----------------------------------------------------------------------
+// Check if the fixup waits (directly or not) for a circular dependency
+// to resolve. Report the cycle if so.
+static int fixup_cycle(struct emas_ctx *ctx, struct fixup *f)
+{
+	char buf[MAX_ERRLEN+1];
+	int len = 0;
+
+	// follow 'waits for a symbol defined by' links. After more steps
+	// than there are fixups, we must be going around in a cycle.
+	for (int i=0 ; i<=ctx->fixup_count ; i++) {
+		if (!f || !f->wait) {
+			return 0;
+		}
+		f = fixup_definer(ctx, f->wait);
+	}
+
+	if (!f) {
+		return 0;
+	}
+
+	struct fixup *start = f;
+	do {
+		len += snprintf(buf+len, MAX_ERRLEN-len, "%s -> ", f->wait->name);
+		if (len >= MAX_ERRLEN) break;
+		f = fixup_definer(ctx, f->wait);
+	} while (f != start);
+
+	if (len < MAX_ERRLEN) {
+		snprintf(buf+len, MAX_ERRLEN-len, "%s", start->wait->name);
+	}
+
+	aaerror(ctx, start->t, "Circular symbol dependency: %s", buf);
+
+	return 1;
+}
+
+// -----------------------------------------------------------------------
+// Check if the node changes value of an already defined variable
+static int var_redefined(struct emas_ctx *ctx, struct st *t)
+{
+	if (t->type != N_EQU) {
+		return 0;
+	}
+
+	struct dh_elem *s = sym_get(ctx, t->str);
+
+	return s && !(s->type & (SYM_UNDEFINED | SYM_CONST));
+}
+
+// -----------------------------------------------------------------------
+// Lay out the program: evaluate each top-level node once, in order.
+// Nodes depending on symbols not defined yet go to the fixup list.
+// Statements that produce (or may produce) any output are collected
+// in the statement array, so later passes don't need to follow the tree.
+// Statements that only need to be encoded get their size here,
+// encoding is done after the layout.
+static int layout(struct emas_ctx *ctx, struct st *prog)
 {
-	AADEBUG("==== Assemble ================================");
 	struct st *t = prog->args;
-	int u = 0;
-	int uret = 0;
+	int encoded = 0;
+	char aerr[MAX_ERRLEN+1];
+	int u;
 
-	ic = 0;
+	ctx->ic = 0;
+	ctx->stmt_count = 0;
+	ctx->fixup_count = 0;
 
 	while (t) {
-		if (ic > ic_max) {
-			aaerror(t, "Program too large (>%i words)", ic_max+1);
+		if (ctx->ic > ctx->ic_max) {
+			aaerror(ctx, t, "Program too large (>%i words)", ctx->ic_max+1);
 			return -1;
 		}
-		if (t->ic < 0) {
-			t->ic = ic;
+		t->ic = ctx->ic;
+		if (encode_deferred(t)) {
+			t->size = encode_size(t);
+			// data run may not start the last element outside the program space
+			if (ctx->ic + t->size - data_elem_size(t->type) > ctx->ic_max) {
+				aaerror(ctx, t, "Program too large (>%i words)", ctx->ic_max+1);
+				return -1;
+			}
+			u = 0;
 		} else {
-			ic = t->ic;
+			// statements using the variable need to see its current value
+			if (var_redefined(ctx, t)) {
+				if (encode(ctx, encoded, ctx->stmt_count)) {
+					return -1;
+				}
+				encoded = ctx->stmt_count;
+			}
+			AADEBUG(ctx, "---- IC=%i, Top node: %s ----", ctx->ic, eval_tab[t->type].name);
+			ctx->unresolved = NULL;
+			u = eval(ctx, t);
+			AADEBUG(ctx, "---- eval ret: %i", u);
+			if (u < 0) {
+				// errors in statements that come first take precedence
+				strcpy(aerr, ctx->aerr);
+				if (encode(ctx, encoded, ctx->stmt_count)) {
+					return -1;
+				}
+				strcpy(ctx->aerr, aerr);
+				return u;
+			} else if ((u > 0) && fixup_add(ctx, t)) {
+				return -1;
+			}
 		}
-		AADEBUG("---- IC=%i, Top node: %s ----", ic, eval_tab[t->type].name);
-		u = eval(t);
-		AADEBUG("---- eval ret: %i", u);
-		ic += t->size;
-		if ((u < 0) || ((u > 0) && !keep_going)) {
-			return u;
-		} else {
-			uret += u;
+		if (((u > 0) || (t->type != N_NONE)) && stmt_add(ctx, t)) {
+			return -1;
 		}
+		ctx->ic += t->size;
 		t = t->next;
 	}
 
-	return uret;
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Evaluate definitions of all symbols that are not constant yet,
+// so encoding workers only need to read them. Errors are not reported
+// here: statements using such symbols will report them.
+static void sym_finalize_table(struct emas_ctx *ctx, struct dh_table *dh)
+{
+	for (unsigned i=0 ; i<dh->size ; i++) {
+		struct dh_elem *s = dh->slots[i].elem;
+		if (!s) continue;
+		if (s->locals) {
+			sym_finalize_table(ctx, s->locals);
+		}
+		if ((s->type & SYM_UNDEFINED) || !s->t) continue;
+		if ((s->t->type == N_INT) || (s->t->type == N_FLO)) continue;
+		ctx->unresolved = NULL;
+		eval(ctx, s->t);
+	}
+}
+
+// -----------------------------------------------------------------------
+static void sym_finalize(struct emas_ctx *ctx)
+{
+	char aerr[MAX_ERRLEN+1];
+
+	strcpy(aerr, ctx->aerr);
+	sym_finalize_table(ctx, ctx->sym);
+	strcpy(ctx->aerr, aerr);
+}
+
+// -----------------------------------------------------------------------
+// Add statements that could not be encoded (because of undefined symbols)
+// to the fixup list, keeping the list in program order
+static int fixup_add_unencoded(struct emas_ctx *ctx)
+{
+	int count = ctx->fixup_count;
+	struct fixup *old = NULL;
+
+	if (count) {
+		old = malloc(count * sizeof(struct fixup));
+		if (!old) {
+			aaerror(ctx, NULL, "Cannot allocate memory for the fixup list");
+			return -1;
+		}
+		memcpy(old, ctx->fixups, count * sizeof(struct fixup));
+		ctx->fixup_count = 0;
+	}
+
+	// fixups are in the statement array too, in the same order
+	for (int i=0, j=0 ; i<ctx->stmt_count ; i++) {
+		struct st *t = ctx->stmts[i];
+		if ((j < count) && (old[j].t == t)) {
+			ctx->unresolved = old[j].wait;
+			j++;
+		} else if (encode_deferred(t)) {
+			// evaluate again to see what it waits for
+			ctx->ic = t->ic;
+			ctx->unresolved = NULL;
+			eval(ctx, t);
+		} else {
+			continue;
+		}
+		if (fixup_add(ctx, t)) {
+			free(old);
+			return -1;
+		}
+	}
+
+	free(old);
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Check if the fixup may be evaluated again
+static int fixup_ready(struct emas_ctx *ctx, struct fixup *f)
+{
+	if (!f->wait || !(f->wait->type & SYM_UNDEFINED)) {
+		return 1;
+	}
+
+	return ctx->externs && (f->wait->type & SYM_GLOBAL);
+}
+
+// -----------------------------------------------------------------------
+// Evaluate nodes from the fixup list. Each node is retried only when
+// the symbol it waits for gets defined, so nodes resolve in dependency order.
+// In relocatable modules, global symbols still undefined after that
+// are external: nodes waiting for them are retried once more.
+// Then encode the statements deferred by the layout.
+static int resolve(struct emas_ctx *ctx)
+{
+	int progress = 1;
+	int u;
+
+	while (ctx->fixup_count && progress) {
+		int pending = 0;
+		progress = 0;
+		for (int i=0 ; i<ctx->fixup_count ; i++) {
+			struct fixup *f = ctx->fixups + i;
+			if (fixup_ready(ctx, f)) {
+				AADEBUG(ctx, "---- Fixup IC=%i, node: %s ----", f->t->ic, eval_tab[f->t->type].name);
+				ctx->ic = f->t->ic;
+				ctx->unresolved = NULL;
+				u = eval(ctx, f->t);
+				AADEBUG(ctx, "---- eval ret: %i", u);
+				if (u < 0) {
+					return u;
+				} else if (u == 0) {
+					progress = 1;
+					continue;
+				}
+				f->wait = ctx->unresolved;
+			}
+			// keep the list in program order
+			ctx->fixups[pending++] = *f;
+		}
+		ctx->fixup_count = pending;
+		if (!progress && ctx->relocatable && !ctx->externs) {
+			AADEBUG(ctx, "---- External symbols ----");
+			ctx->externs = 1;
+			progress = 1;
+		}
+	}
+
+	// deferred statements may refer to external symbols too
+	ctx->externs = ctx->relocatable;
+
+	AADEBUG(ctx, "==== Encode ==================================");
+	sym_finalize(ctx);
+	if (encode(ctx, 0, ctx->stmt_count)) {
+		return -1;
+	}
+
+	if (fixup_add_unencoded(ctx)) {
+		return -1;
+	}
+
+	if (ctx->fixup_count) {
+		// report the first node that couldn't be resolved
+		struct fixup *f = ctx->fixups;
+		if (!fixup_cycle(ctx, f)) {
+			// evaluate again to get the actual error
+			ctx->ic = f->t->ic;
+			eval(ctx, f->t);
+		}
+		return -1;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+int assemble(struct emas_ctx *ctx, struct st *prog)
+{
+	int u;
+
+	AADEBUG(ctx, "==== Assemble ================================");
+	ctx->externs = 0;
+	u = layout(ctx, prog);
+	if (u) return u;
+
+	AADEBUG(ctx, "==== Fixups (%i) =============================", ctx->fixup_count);
+	return resolve(ctx);
 }
 
 // -----------------------------------------------------------------------
-int add_const(char *name, int val)
+// Define a constant (name is an atom)
+int add_const(struct emas_ctx *ctx, char *name, int val)
 {
 	struct dh_elem *s;
 
-	s = dh_get(sym, name);
+	s = sym_get(ctx, name);
 
 	if (!s) {
-		struct st *t = st_int(N_INT, val);
-		dh_addt(sym, name, SYM_CONST, t);
+		struct st *t = st_int(ctx, N_INT, val);
+		sym_add(ctx, name, SYM_CONST, t);
 	} else {
-		s->value = val;
+		s->t->val = val;
 	}
 
 	return 0;
@@ -20,38 +20,26 @@
 
 #include <inttypes.h>
 
+#include "libemas.h"
 #include "dh.h"
 #include "st.h"
 
 #define MAX_ERRLEN 1024
 
-typedef int (*eval_fun)(struct st *t);
-
-extern struct dh_table *sym;
-extern struct st *program;
-extern struct st *entry;
-extern int cpu;
-
-extern char aerr[MAX_ERRLEN+1];
-extern int aadebug;
-
-enum cpu_types {
-	CPU_DEFAULT			= 0,
-	CPU_FORCED			= 1 << 0,
-	CPU_MERA400			= 1 << 1,
-	CPU_MX16			= 1 << 2,
-};
+typedef int (*eval_fun)(struct emas_ctx *ctx, struct st *t);
 
 enum sym_types {
 	SYM_UNDEFINED	= 0b00000001,
 	SYM_CONST		= 0b00000100,
 	SYM_GLOBAL		= 0b00001000,
+	SYM_PLACEHOLDER	= 0b00010000,	// created by a reference, not defined (yet)
 };
 
 enum node_types {
 	N_NONE = 0,
 	N_INT,
 	N_BLOB,
+	N_FILL,
 	N_FLO,
 	N_PLUS,
 	N_MINUS,
@@ -98,6 +86,7 @@ enum node_types {
 	N_OP_HLT,
 	N_PROG,
 	N_NORM,
+	N_RELOC,
 	N_MAX,
 };
 
@@ -108,39 +97,47 @@ struct eval_t {
 
 extern struct eval_t eval_tab[];
 
-void AADEBUG(char *format, ...);
-void aaerror(struct st *t, char *format, ...);
-
-int prog_cpu(char *cpu_name, int force);
-
-int eval_1arg(struct st *t);
-int eval_2arg(struct st *t);
-int eval_float(struct st *t);
-int eval_word(struct st *t);
-int eval_multiword(struct st *t);
-int eval_res(struct st *t);
-int eval_org(struct st *t);
-int eval_string(struct st *t);
-int eval_label(struct st *t);
-int eval_equ(struct st *t);
-int eval_const(struct st *t);
-int eval_entry(struct st *t);
-int eval_global(struct st *t);
-int eval_ifdef(struct st *t);
-int eval_struct(struct st *t);
-int eval_struct_field(struct st *t);
-int eval_name(struct st *t);
-int eval_curloc(struct st *t);
-int eval_as_short(struct st *t, int type, int op);
-int eval_op_short(struct st *t);
-int eval_op_mx16(struct st *t);
-int eval_op_noarg(struct st *t);
-int eval_none(struct st *t);
-int eval_err(struct st *t);
-
-int eval(struct st *t);
-int assemble(struct st *prog, int keep_going);
-int add_const(char *name, int val);
+// Top-level node that could not be evaluated during layout
+struct fixup {
+	struct st *t;
+	struct dh_elem *wait;	// undefined symbol the evaluation stopped at (if known)
+};
+
+void AADEBUG(struct emas_ctx *ctx, char *format, ...);
+void aaerror(struct emas_ctx *ctx, struct st *t, char *format, ...);
+
+int prog_cpu(struct emas_ctx *ctx, int cpu, int force);
+
+int eval_float(struct emas_ctx *ctx, struct st *t);
+int data_elem_size(int type);
+int data_put(struct emas_ctx *ctx, struct st *t, struct st *e, int report);
+int eval_data(struct emas_ctx *ctx, struct st *t);
+int eval_res(struct emas_ctx *ctx, struct st *t);
+int eval_org(struct emas_ctx *ctx, struct st *t);
+int eval_string(struct emas_ctx *ctx, struct st *t);
+int eval_label(struct emas_ctx *ctx, struct st *t);
+int eval_equ(struct emas_ctx *ctx, struct st *t);
+int eval_const(struct emas_ctx *ctx, struct st *t);
+int eval_entry(struct emas_ctx *ctx, struct st *t);
+int eval_global(struct emas_ctx *ctx, struct st *t);
+int eval_ifdef(struct emas_ctx *ctx, struct st *t);
+int eval_struct(struct emas_ctx *ctx, struct st *t);
+int eval_struct_field(struct emas_ctx *ctx, struct st *t);
+int eval_as_short(struct emas_ctx *ctx, struct st *t, int type, int op);
+int eval_op_short(struct emas_ctx *ctx, struct st *t);
+int eval_op_mx16(struct emas_ctx *ctx, struct st *t);
+int eval_op_noarg(struct emas_ctx *ctx, struct st *t);
+int eval_none(struct emas_ctx *ctx, struct st *t);
+int eval_err(struct emas_ctx *ctx, struct st *t);
+
+int eval(struct emas_ctx *ctx, struct st *t);
+int assemble(struct emas_ctx *ctx, struct st *prog);
+int add_const(struct emas_ctx *ctx, char *name, int val);
+void sym_clear(struct emas_ctx *ctx);
+struct dh_elem * sym_get(struct emas_ctx *ctx, char *name);
+struct dh_elem * sym_add(struct emas_ctx *ctx, char *name, int type, struct st *t);
+struct dh_elem * sym_ref(struct emas_ctx *ctx, char *name);
+void bind_names(struct emas_ctx *ctx, struct st *t);
 
 #endif
 
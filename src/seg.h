@@ -0,0 +1,59 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+#ifndef SEG_H
+#define SEG_H
+
+// Segmented program image, as written by "emas -O seg". File consists
+// of 16-bit big-endian words, 32-bit values are stored as two words,
+// most significant one first. All entries have fixed size, so a loader
+// can map the file and copy segments straight from where the table points.
+//
+// header:
+//   magic[2]      : SEG_MAGIC_HI, SEG_MAGIC_LO ("EMSG")
+//   version       : SEG_VERSION
+//   flags         : SEG_ENTRY if the entry point is set
+//   cpu           : CPU type the program was assembled for (enum cpu_types)
+//   entry         : program entry point
+//   count (32)    : number of segments
+// segment table (segments are in address order, they don't overlap):
+//   addr (32)     : load address
+//   len (32)      : segment length in words
+//   flags         : SEG_FILL if the segment is filled with a value
+//   fill          : fill value
+//   offset (32)   : position of the segment data in the file (in words),
+//                   0 for fills
+// segment data, packed
+
+#define SEG_MAGIC_HI	0x454d
+#define SEG_MAGIC_LO	0x5347
+#define SEG_VERSION		1
+#define SEG_HEADER_WORDS	8
+#define SEG_ENTRY_WORDS		8
+
+enum seg_header_flags {
+	SEG_ENTRY	= 1 << 0,
+};
+
+enum seg_flags {
+	SEG_FILL	= 1 << 0,
+};
+
+#endif
+
+// vim: tabstop=4 autoindent
@@ -0,0 +1,799 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "libemas.h"
+#include "server.h"
+
+// Requests and responses are sequences of records:
+//   tag (1 byte), data length (4 bytes, big endian), data
+// Request ends with R_END record, response ends with R_RESULT record.
+
+struct request {
+	char *cwd;
+	int cpu;
+	int debug;
+	int otype;
+	char **inc_paths;
+	char **defs;
+	char *source;
+	char *text;
+	int text_len;
+	char *output;
+};
+
+// contents of an included file, shared by the cache and open streams
+struct inc_data {
+	char *data;
+	off_t size;
+	int refs;
+};
+
+// cached contents of included files
+struct inc_file {
+	char *path;
+	dev_t dev;
+	ino_t ino;
+	struct timespec mtime;
+	off_t size;
+	struct inc_data *d;
+	struct inc_file *next;
+};
+
+// stream reading cached file contents
+struct inc_stream {
+	struct inc_data *d;
+	off_t pos;
+};
+
+static struct inc_file *inc_cache;
+static pthread_mutex_t inc_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct emas_ctx *ctx_pool[64];
+static int ctx_pool_count;
+static pthread_mutex_t ctx_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int conn_count;
+static pthread_mutex_t conn_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t conn_cond = PTHREAD_COND_INITIALIZER;
+
+static volatile sig_atomic_t server_quit;
+
+// -----------------------------------------------------------------------
+static int fd_write(int fd, const void *buf, size_t len)
+{
+	const char *p = buf;
+
+	while (len > 0) {
+		ssize_t res = write(fd, p, len);
+		if (res < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		p += res;
+		len -= res;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int fd_read(int fd, void *buf, size_t len)
+{
+	char *p = buf;
+
+	while (len > 0) {
+		ssize_t res = read(fd, p, len);
+		if (res < 0) {
+			if (errno == EINTR) continue;
+			return -1;
+		} else if (res == 0) {
+			return -1;
+		}
+		p += res;
+		len -= res;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int rec_put(int fd, int tag, const void *data, size_t len)
+{
+	unsigned char hdr[5];
+
+	hdr[0] = tag;
+	hdr[1] = (len >> 24) & 0xff;
+	hdr[2] = (len >> 16) & 0xff;
+	hdr[3] = (len >> 8) & 0xff;
+	hdr[4] = len & 0xff;
+
+	if (fd_write(fd, hdr, 5)) {
+		return -1;
+	}
+
+	return fd_write(fd, data, len);
+}
+
+// -----------------------------------------------------------------------
+static int rec_put_str(int fd, int tag, const char *str)
+{
+	return rec_put(fd, tag, str, strlen(str));
+}
+
+// -----------------------------------------------------------------------
+static int rec_put_int(int fd, int tag, int v)
+{
+	char buf[32];
+	snprintf(buf, 32, "%i", v);
+	return rec_put_str(fd, tag, buf);
+}
+
+// -----------------------------------------------------------------------
+// Read one record. Data is NUL-terminated and needs to be freed.
+static int rec_get(int fd, int *tag, char **data, int *len)
+{
+	unsigned char hdr[5];
+
+	if (fd_read(fd, hdr, 5)) {
+		return -1;
+	}
+
+	*tag = hdr[0];
+	*len = (hdr[1] << 24) | (hdr[2] << 16) | (hdr[3] << 8) | hdr[4];
+	if ((*len < 0) || (*len > SERVER_REC_MAX)) {
+		return -1;
+	}
+
+	*data = malloc(*len + 1);
+	if (!*data) {
+		return -1;
+	}
+	if (fd_read(fd, *data, *len)) {
+		free(*data);
+		return -1;
+	}
+	(*data)[*len] = '\0';
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int sock_addr(struct sockaddr_un *addr, char *sock_path)
+{
+	memset(addr, 0, sizeof(struct sockaddr_un));
+	addr->sun_family = AF_UNIX;
+	if (strlen(sock_path) >= sizeof(addr->sun_path)) {
+		fprintf(stderr, "Socket path too long: '%s'\n", sock_path);
+		return -1;
+	}
+	strcpy(addr->sun_path, sock_path);
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Drop a reference to file contents (inc_lock needs to be held)
+static void inc_data_put(struct inc_data *d)
+{
+	if (d && (--d->refs == 0)) {
+		free(d->data);
+		free(d);
+	}
+}
+
+// -----------------------------------------------------------------------
+static ssize_t inc_stream_read(void *cookie, char *buf, size_t size)
+{
+	struct inc_stream *s = cookie;
+	off_t left = s->d->size - s->pos;
+
+	if ((off_t) size > left) {
+		size = left;
+	}
+	memcpy(buf, s->d->data + s->pos, size);
+	s->pos += size;
+
+	return size;
+}
+
+// -----------------------------------------------------------------------
+// Stream is closed: contents are freed when nothing else uses them
+static int inc_stream_close(void *cookie)
+{
+	struct inc_stream *s = cookie;
+
+	pthread_mutex_lock(&inc_lock);
+	inc_data_put(s->d);
+	pthread_mutex_unlock(&inc_lock);
+	free(s);
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Read file contents, NULL if it cannot be read
+static struct inc_data * inc_data_read(const char *path, off_t size)
+{
+	struct inc_data *d = calloc(1, sizeof(struct inc_data));
+	FILE *in = fopen(path, "r");
+
+	if (d && in) {
+		d->data = malloc(size);
+		if (d->data && (fread(d->data, 1, size, in) == (size_t) size)) {
+			d->size = size;
+			d->refs = 1;
+			fclose(in);
+			return d;
+		}
+		free(d->data);
+	}
+
+	free(d);
+	if (in) fclose(in);
+
+	return NULL;
+}
+
+// -----------------------------------------------------------------------
+// Included file opener for the library: file contents are kept
+// in memory and reread only when file changes on disk
+static FILE * inc_cached_open(const char *path, void *data)
+{
+	static const cookie_io_functions_t io = { inc_stream_read, NULL, NULL, inc_stream_close };
+	struct stat st;
+	struct inc_file *f;
+	struct inc_stream *s;
+	FILE *stream;
+
+	if (stat(path, &st) || !S_ISREG(st.st_mode) || (st.st_size == 0)) {
+		return fopen(path, "r");
+	}
+
+	s = malloc(sizeof(struct inc_stream));
+	if (!s) {
+		return fopen(path, "r");
+	}
+	s->d = NULL;
+	s->pos = 0;
+
+	pthread_mutex_lock(&inc_lock);
+
+	f = inc_cache;
+	while (f) {
+		if (!strcmp(f->path, path)) break;
+		f = f->next;
+	}
+
+	// file may be replaced or changed within the same second
+	if (!f || (f->dev != st.st_dev) || (f->ino != st.st_ino) || (f->size != st.st_size)
+		|| (f->mtime.tv_sec != st.st_mtim.tv_sec) || (f->mtime.tv_nsec != st.st_mtim.tv_nsec)) {
+		struct inc_data *d = inc_data_read(path, st.st_size);
+		if (d) {
+			if (!f) {
+				f = calloc(1, sizeof(struct inc_file));
+				f->path = strdup(path);
+				f->next = inc_cache;
+				inc_cache = f;
+			}
+			// old contents live as long as streams reading them
+			inc_data_put(f->d);
+			f->dev = st.st_dev;
+			f->ino = st.st_ino;
+			f->mtime = st.st_mtim;
+			f->size = st.st_size;
+			f->d = d;
+		} else {
+			f = NULL;
+		}
+	}
+
+	if (f) {
+		s->d = f->d;
+		s->d->refs++;
+	}
+
+	pthread_mutex_unlock(&inc_lock);
+
+	if (!s->d) {
+		free(s);
+		return fopen(path, "r");
+	}
+
+	stream = fopencookie(s, "r", io);
+	if (!stream) {
+		inc_stream_close(s);
+		return fopen(path, "r");
+	}
+
+	return stream;
+}
+
+// -----------------------------------------------------------------------
+static void inc_cache_drop(struct inc_file *f)
+{
+	while (f) {
+		struct inc_file *next = f->next;
+		free(f->path);
+		inc_data_put(f->d);
+		free(f);
+		f = next;
+	}
+}
+
+// -----------------------------------------------------------------------
+static struct emas_ctx * ctx_get()
+{
+	struct emas_ctx *ctx = NULL;
+
+	pthread_mutex_lock(&ctx_lock);
+	if (ctx_pool_count > 0) {
+		ctx = ctx_pool[--ctx_pool_count];
+	}
+	pthread_mutex_unlock(&ctx_lock);
+
+	if (!ctx) {
+		ctx = emas_create();
+	}
+
+	return ctx;
+}
+
+// -----------------------------------------------------------------------
+static void ctx_put(struct emas_ctx *ctx)
+{
+	pthread_mutex_lock(&ctx_lock);
+	if (ctx_pool_count < 64) {
+		ctx_pool[ctx_pool_count++] = ctx;
+		ctx = NULL;
+	}
+	pthread_mutex_unlock(&ctx_lock);
+
+	emas_destroy(ctx);
+}
+
+// -----------------------------------------------------------------------
+static void request_free(struct request *r)
+{
+	free(r->cwd);
+	emas_list_free(r->inc_paths);
+	emas_list_free(r->defs);
+	free(r->source);
+	free(r->text);
+	free(r->output);
+}
+
+// -----------------------------------------------------------------------
+static int request_read(int fd, struct request *r)
+{
+	int tag;
+	char *data;
+	int len;
+
+	while (!rec_get(fd, &tag, &data, &len)) {
+		switch (tag) {
+			case R_CWD:
+				free(r->cwd);
+				r->cwd = data;
+				break;
+			case R_CPU:
+				r->cpu = atoi(data);
+				free(data);
+				break;
+			case R_DEBUG:
+				r->debug = atoi(data);
+				free(data);
+				break;
+			case R_OTYPE:
+				r->otype = atoi(data);
+				free(data);
+				break;
+			case R_INCLUDE:
+				emas_list_add(&r->inc_paths, data);
+				free(data);
+				break;
+			case R_DEFINE:
+				emas_list_add(&r->defs, data);
+				free(data);
+				break;
+			case R_SOURCE:
+				free(r->source);
+				r->source = data;
+				break;
+			case R_TEXT:
+				free(r->text);
+				r->text = data;
+				r->text_len = len;
+				break;
+			case R_OUTPUT:
+				free(r->output);
+				r->output = data;
+				break;
+			case R_END:
+				free(data);
+				return 0;
+			default:
+				free(data);
+				return -1;
+		}
+	}
+
+	return -1;
+}
+
+// -----------------------------------------------------------------------
+static int request_handle(int fd, struct request *r)
+{
+	int res = 1;
+	char *diag = NULL;
+	size_t diag_len = 0;
+	char *obuf = NULL;
+	size_t obuf_len = 0;
+	FILE *of = NULL;
+	FILE *inf = NULL;
+
+	FILE *errf = open_memstream(&diag, &diag_len);
+	if (!errf) {
+		return -1;
+	}
+
+	struct emas_opts opts = {
+		.cpu = r->cpu,
+		.inc_paths = r->inc_paths,
+		.defs = r->defs,
+		.errf = errf,
+		.debug = r->debug,
+		.cwd = r->cwd,
+		.inc_open = inc_cached_open,
+		.inc_open_data = NULL,
+	};
+	struct emas_out out = { r->otype, r->output, NULL };
+
+	if (!r->output) {
+		// output goes back to the client
+		of = open_memstream(&obuf, &obuf_len);
+		out.name = "(stdout)";
+		out.f = of;
+	}
+
+	struct emas_ctx *ctx = ctx_get();
+
+	if (!ctx) {
+		fprintf(errf, "Failed to create assembler context.\n");
+	} else if (r->source) {
+		res = emas_assemble(ctx, r->source, &opts, &out);
+	} else {
+		if (r->text && (r->text_len > 0)) {
+			inf = fmemopen(r->text, r->text_len, "r");
+		} else {
+			inf = fopen("/dev/null", "r");
+		}
+		if (inf) {
+			res = emas_assemble_stream(ctx, inf, "(stdin)", &opts, &out);
+			fclose(inf);
+		} else {
+			fprintf(errf, "Cannot open source text.\n");
+		}
+	}
+
+	if (ctx) ctx_put(ctx);
+
+	fclose(errf);
+	if (of) fclose(of);
+
+	int err = 0;
+	if (obuf_len > 0) {
+		err |= rec_put(fd, R_OUTPUT, obuf, obuf_len);
+	}
+	if (diag_len > 0) {
+		err |= rec_put(fd, R_DIAG, diag, diag_len);
+	}
+	err |= rec_put_int(fd, R_RESULT, res);
+
+	free(obuf);
+	free(diag);
+
+	return err;
+}
+
+// -----------------------------------------------------------------------
+static void * server_conn(void *ptr)
+{
+	int fd = (int) (long) ptr;
+	struct request r = { 0 };
+
+	if (!request_read(fd, &r)) {
+		request_handle(fd, &r);
+	}
+	request_free(&r);
+	close(fd);
+
+	pthread_mutex_lock(&conn_lock);
+	conn_count--;
+	pthread_cond_signal(&conn_cond);
+	pthread_mutex_unlock(&conn_lock);
+
+	return NULL;
+}
+
+// -----------------------------------------------------------------------
+static void server_sig(int sig)
+{
+	server_quit = 1;
+}
+
+// -----------------------------------------------------------------------
+// Remove socket left over by a server that is not running anymore.
+// Anything else found at the path is left alone.
+static int sock_stale_remove(char *sock_path, struct sockaddr_un *addr)
+{
+	struct stat st;
+
+	if (lstat(sock_path, &st)) {
+		if (errno == ENOENT) {
+			return 0;
+		}
+		fprintf(stderr, "Cannot check socket path '%s': %s\n", sock_path, strerror(errno));
+		return -1;
+	}
+
+	if (!S_ISSOCK(st.st_mode)) {
+		fprintf(stderr, "Socket path '%s' exists and is not a socket\n", sock_path);
+		return -1;
+	}
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		fprintf(stderr, "Cannot create socket: %s\n", strerror(errno));
+		return -1;
+	}
+	int res = connect(fd, (struct sockaddr *) addr, sizeof(struct sockaddr_un));
+	int err = errno;
+	close(fd);
+
+	if (!res) {
+		fprintf(stderr, "Another server is already listening on '%s'\n", sock_path);
+		return -1;
+	} else if (err != ECONNREFUSED) {
+		fprintf(stderr, "Cannot check socket '%s': %s\n", sock_path, strerror(err));
+		return -1;
+	}
+
+	if (unlink(sock_path)) {
+		fprintf(stderr, "Cannot remove stale socket '%s': %s\n", sock_path, strerror(errno));
+		return -1;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Serve assembly requests on a Unix socket, until SIGINT or SIGTERM
+int server_run(char *sock_path)
+{
+	struct sockaddr_un addr;
+	struct sigaction sa;
+	pthread_attr_t attr;
+	pthread_t thread;
+	int i;
+
+	if (sock_addr(&addr, sock_path)) {
+		return 1;
+	}
+
+	int sfd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (sfd < 0) {
+		fprintf(stderr, "Cannot create socket: %s\n", strerror(errno));
+		return 1;
+	}
+
+	if (sock_stale_remove(sock_path, &addr)) {
+		close(sfd);
+		return 1;
+	}
+
+	if (bind(sfd, (struct sockaddr *) &addr, sizeof(addr)) || listen(sfd, 64)) {
+		fprintf(stderr, "Cannot listen on '%s': %s\n", sock_path, strerror(errno));
+		close(sfd);
+		return 1;
+	}
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = server_sig;
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+	signal(SIGPIPE, SIG_IGN);
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+	while (!server_quit) {
+		int fd = accept(sfd, NULL, NULL);
+		if (fd < 0) {
+			if ((errno == EINTR) || (errno == ECONNABORTED)) continue;
+			fprintf(stderr, "Cannot accept connection: %s\n", strerror(errno));
+			break;
+		}
+
+		pthread_mutex_lock(&conn_lock);
+		conn_count++;
+		pthread_mutex_unlock(&conn_lock);
+
+		if (pthread_create(&thread, &attr, server_conn, (void*) (long) fd)) {
+			// no thread, handle the request here
+			server_conn((void*) (long) fd);
+		}
+	}
+
+	close(sfd);
+	unlink(sock_path);
+	pthread_attr_destroy(&attr);
+
+	// wait for requests in progress
+	pthread_mutex_lock(&conn_lock);
+	while (conn_count > 0) {
+		pthread_cond_wait(&conn_cond, &conn_lock);
+	}
+	pthread_mutex_unlock(&conn_lock);
+
+	for (i=0 ; i<ctx_pool_count ; i++) {
+		emas_destroy(ctx_pool[i]);
+	}
+	ctx_pool_count = 0;
+	pthread_mutex_lock(&inc_lock);
+	inc_cache_drop(inc_cache);
+	inc_cache = NULL;
+	pthread_mutex_unlock(&inc_lock);
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static char * stream_slurp(FILE *f, int *len)
+{
+	int size = 0;
+	int cap = 4096;
+	size_t res;
+	char *buf = malloc(cap);
+
+	while (buf) {
+		res = fread(buf+size, 1, cap-size, f);
+		size += res;
+		if (res == 0) break;
+		if (size == cap) {
+			if (cap >= SERVER_REC_MAX) {
+				free(buf);
+				return NULL;
+			}
+			char *nbuf = realloc(buf, cap*2);
+			if (!nbuf) {
+				free(buf);
+				return NULL;
+			}
+			buf = nbuf;
+			cap *= 2;
+		}
+	}
+
+	*len = size;
+
+	return buf;
+}
+
+// -----------------------------------------------------------------------
+// Have the server assemble the source.
+// Returns -1 if the server cannot be reached (nothing is done in that case),
+// assembly result otherwise.
+int client_assemble(char *sock_path, char *input, struct emas_opts *opts, struct emas_out *out)
+{
+	struct sockaddr_un addr;
+	char cwd[PATH_MAX];
+	char **s;
+	int err = 0;
+	int res = 1;
+	int tag;
+	char *data;
+	int len;
+
+	if (sock_addr(&addr, sock_path)) {
+		return -1;
+	}
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		return -1;
+	}
+	if (connect(fd, (struct sockaddr *) &addr, sizeof(addr))) {
+		close(fd);
+		return -1;
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+
+	if (getcwd(cwd, PATH_MAX)) {
+		err |= rec_put_str(fd, R_CWD, cwd);
+	}
+	err |= rec_put_int(fd, R_CPU, opts->cpu);
+	err |= rec_put_int(fd, R_DEBUG, opts->debug);
+	err |= rec_put_int(fd, R_OTYPE, out->type);
+	for (s=opts->inc_paths ; s && *s ; s++) {
+		err |= rec_put_str(fd, R_INCLUDE, *s);
+	}
+	for (s=opts->defs ; s && *s ; s++) {
+		err |= rec_put_str(fd, R_DEFINE, *s);
+	}
+	if (input) {
+		err |= rec_put_str(fd, R_SOURCE, input);
+	} else {
+		char *text = stream_slurp(stdin, &len);
+		if (!text) {
+			fprintf(stderr, "Cannot read source from stdin.\n");
+			close(fd);
+			return 1;
+		}
+		err |= rec_put(fd, R_TEXT, text, len);
+		free(text);
+	}
+	if (!out->f && strcmp(out->name, "-")) {
+		err |= rec_put_str(fd, R_OUTPUT, out->name);
+	}
+	err |= rec_put(fd, R_END, NULL, 0);
+
+	if (err) {
+		fprintf(stderr, "Cannot send request to the assembler server.\n");
+		close(fd);
+		return 1;
+	}
+
+	while (!rec_get(fd, &tag, &data, &len)) {
+		switch (tag) {
+			case R_OUTPUT:
+				fwrite(data, 1, len, out->f ? out->f : stdout);
+				break;
+			case R_DIAG:
+				fwrite(data, 1, len, stderr);
+				break;
+			case R_RESULT:
+				res = atoi(data);
+				free(data);
+				close(fd);
+				return res;
+		}
+		free(data);
+	}
+
+	fprintf(stderr, "Assembler server closed the connection.\n");
+	close(fd);
+
+	return 1;
+}
+
+// vim: tabstop=4 autoindent
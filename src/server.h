@@ -0,0 +1,46 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "libemas.h"
+
+#define SERVER_REC_MAX (16*1024*1024)
+
+// request/response record tags
+enum server_tags {
+	R_CWD		= 'W',	// client working directory
+	R_CPU		= 'C',	// CPU type
+	R_DEBUG		= 'G',	// debug flag
+	R_OTYPE		= 'T',	// output type
+	R_INCLUDE	= 'I',	// include directory
+	R_DEFINE	= 'D',	// constant definition
+	R_SOURCE	= 'S',	// source file name
+	R_TEXT		= 'X',	// inline source text
+	R_OUTPUT	= 'O',	// output file name (request) or output data (response)
+	R_DIAG		= 'M',	// diagnostic messages
+	R_RESULT	= 'R',	// assembly result
+	R_END		= 'E',	// end of request
+};
+
+int server_run(char *sock_path);
+int client_assemble(char *sock_path, char *input, struct emas_opts *opts, struct emas_out *out);
+
+#endif
+
+// vim: tabstop=4 autoindent
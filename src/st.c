@@ -20,33 +20,117 @@
 #include <string.h>
 
 #include "st.h"
-#include "parser.h"
+#include "ctx.h"
 
-extern int ic;
+// -----------------------------------------------------------------------
+// Get location table index for a location: consecutive nodes created
+// for the same token share one location table entry
+static uint32_t st_loc_add(struct emas_ctx *ctx, struct st_loc *loc)
+{
+	struct st_loc *l;
+
+	if (ctx->loc_count > 0) {
+		l = ctx->locs + ctx->loc_count - 1;
+		if ((l->file == loc->file) && (l->line == loc->line) && (l->col == loc->col)
+				&& (l->stmt_file == loc->stmt_file) && (l->stmt_line == loc->stmt_line)) {
+			return ctx->loc_count - 1;
+		}
+	}
+
+	if (ctx->loc_count >= ctx->loc_cap) {
+		uint32_t cap = ctx->loc_cap ? ctx->loc_cap * 2 : 1024;
+		l = realloc(ctx->locs, cap * sizeof(struct st_loc));
+		if (!l) {
+			// better a wrong location than none at all
+			return ctx->loc_count ? ctx->loc_count - 1 : 0;
+		}
+		ctx->locs = l;
+		ctx->loc_cap = cap;
+	}
+
+	ctx->locs[ctx->loc_count] = *loc;
+
+	return ctx->loc_count++;
+}
+
+// -----------------------------------------------------------------------
+// Get location index for a new node (at the current token)
+static uint32_t st_loc_new(struct emas_ctx *ctx)
+{
+	struct st_loc loc = {
+		ctx->lloc.filename, ctx->lloc.first_line, ctx->lloc.first_column,
+		ctx->lloc.filename, ctx->lloc.first_line
+	};
+
+	return st_loc_add(ctx, &loc);
+}
+
+// -----------------------------------------------------------------------
+// Nodes are created when the parser already looked at the next token,
+// so statements (instructions come with their data word) get the line
+// of their first token this way. Errors still point at the node's token.
+void st_loc_set(struct emas_ctx *ctx, struct st *t, struct YYLTYPE *lloc)
+{
+	if (!lloc->filename) {
+		return;
+	}
+
+	while (t) {
+		struct st_loc loc = *st_loc(ctx, t);
+		loc.stmt_file = lloc->filename;
+		loc.stmt_line = lloc->first_line;
+		t->loc = st_loc_add(ctx, &loc);
+		t = t->next;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Make the node belong to the statement, keeping its own error location
+void st_loc_stmt(struct emas_ctx *ctx, struct st *t, struct st *stmt)
+{
+	struct st_loc loc = *st_loc(ctx, t);
+	struct st_loc *sloc = st_loc(ctx, stmt);
+
+	loc.stmt_file = sloc->stmt_file;
+	loc.stmt_line = sloc->stmt_line;
+	t->loc = st_loc_add(ctx, &loc);
+}
+
+// -----------------------------------------------------------------------
+struct st_loc * st_loc(struct emas_ctx *ctx, struct st *t)
+{
+	static struct st_loc unknown = { NULL, 0, 0, NULL, 0 };
+
+	if (t->loc >= ctx->loc_count) {
+		return &unknown;
+	}
+
+	return ctx->locs + t->loc;
+}
+
+// -----------------------------------------------------------------------
+void st_loc_reset(struct emas_ctx *ctx)
+{
+	ctx->loc_count = 0;
+}
 
 // -----------------------------------------------------------------------
-struct st * st_new(int type, int64_t val, double flo, char *str, struct st *args)
+struct st * st_new(struct emas_ctx *ctx, int type, int64_t val, char *str, struct st *args)
 {
 	struct st *sx;
 
-	sx = calloc(1, sizeof(struct st));
+	sx = arena_node_get(&ctx->arena);
 	if (!sx) {
 		return NULL;
 	}
 
 	sx->type = type;
 	sx->val = val;
-	sx->flo = flo;
 	sx->args = args;
 	if (str) {
-		if (val>0) {
-			sx->str = malloc(val);
-			sx->str = memcpy(sx->str, str, val);
-		} else {
-			sx->str = strdup(str);
-		}
+		sx->str = arena_memdup(&ctx->arena, str, val>0 ? val : strlen(str)+1);
 		if (!sx->str) {
-			free(sx);
+			arena_node_put(&ctx->arena, sx);
 			return NULL;
 		}
 	}
@@ -54,72 +138,143 @@ struct st * st_new(int type, int64_t val, double flo, char *str, struct st *args
 	sx->ic = -1;
 	sx->size = 0;
 	sx->flags = ST_NONE;
-
-	if (yylloc.filename) {
-		sx->loc_file = yylloc.filename;
-	} else {
-		sx->loc_file = NULL;
-	}
-	sx->loc_line = yylloc.first_line;
-	sx->loc_col = yylloc.first_column;
+	sx->loc = st_loc_new(ctx);
 
 	return sx;
 }
 
 // -----------------------------------------------------------------------
-struct st * st_copy(struct st *t)
+// Get number of words allocated for the node data
+int st_data_words(struct st *t)
+{
+	if (t->flags & ST_SIGNED) {
+		return t->size + (t->size + 15) / 16;
+	}
+	return t->size;
+}
+
+// -----------------------------------------------------------------------
+// Copy a single node (without arguments)
+struct st * st_copy(struct emas_ctx *ctx, struct st *t)
 {
 	if (!t) return NULL;
 
-	struct st *sx = st_new(t->type, t->val, t->flo, t->str, NULL);
+	struct st *sx = arena_node_get(&ctx->arena);
+	if (!sx) {
+		return NULL;
+	}
+
+	*sx = *t;
+	sx->args = sx->next = sx->last = NULL;
+
+	if (t->flags & ST_DATA) {
+		sx->data = arena_memdup(&ctx->arena, t->data, st_data_words(t) * sizeof(uint16_t));
+		if (!sx->data) {
+			arena_node_put(&ctx->arena, sx);
+			return NULL;
+		}
+	}
 
 	return sx;
 }
 
 // -----------------------------------------------------------------------
-void st_drop(struct st *stx)
+// Copy a list of nodes along with all their arguments
+struct st * st_clone(struct emas_ctx *ctx, struct st *t)
+{
+	struct st *head = NULL;
+	struct st *last = NULL;
+
+	while (t) {
+		struct st *sx = st_copy(ctx, t);
+		if (!sx) {
+			st_drop(ctx, head);
+			return NULL;
+		}
+		if (last) {
+			last->next = sx;
+		} else {
+			head = sx;
+		}
+		last = sx;
+
+		if (t->args) {
+			sx->args = st_clone(ctx, t->args);
+			if (!sx->args) {
+				st_drop(ctx, head);
+				return NULL;
+			}
+			sx->last = sx->args;
+			while (sx->last->next) {
+				sx->last = sx->last->next;
+			}
+		}
+
+		t = t->next;
+	}
+
+	return head;
+}
+
+// -----------------------------------------------------------------------
+// Return nodes to the arena for reuse. Strings and data blobs
+// stay in the arena until the assembly is done.
+void st_drop(struct emas_ctx *ctx, struct st *stx)
 {
 	while (stx) {
 		struct st *next = stx->next;
-		free(stx->str);
-		free(stx->data);
-		st_drop(stx->args);
-		free(stx);
+		st_drop(ctx, stx->args);
+		arena_node_put(&ctx->arena, stx);
 		stx = next;
 	}
 }
 
 // -----------------------------------------------------------------------
-struct st * st_int(int type, int64_t val)
+struct st * st_int(struct emas_ctx *ctx, int type, int64_t val)
+{
+	return st_new(ctx, type, val, NULL, NULL);
+}
+
+// -----------------------------------------------------------------------
+struct st * st_float(struct emas_ctx *ctx, int type, double flo)
 {
-	return st_new(type, val, 0, NULL, NULL);
+	struct st *sx = st_new(ctx, type, 0, NULL, NULL);
+	if (sx) {
+		sx->flo = flo;
+	}
+	return sx;
 }
 
 // -----------------------------------------------------------------------
-struct st * st_float(int type, double flo)
+struct st * st_str(struct emas_ctx *ctx, int type, char *str)
 {
-	return st_new(type, 0, flo, NULL, NULL);
+	return st_new(ctx, type, 0, str, NULL);
 }
 
 // -----------------------------------------------------------------------
-struct st * st_str(int type, char *str)
+struct st * st_strval(struct emas_ctx *ctx, int type, char *str, int val)
 {
-	return st_new(type, 0, 0, str, NULL);
+	return st_new(ctx, type, val, str, NULL);
 }
 
 // -----------------------------------------------------------------------
-struct st * st_strval(int type, char *str, int val)
+// Create a node referring to an interned name (no copy is made)
+struct st * st_atom(struct emas_ctx *ctx, int type, char *atom)
 {
-	return st_new(type, val, 0, str, NULL);
+	struct st *sx = st_new(ctx, type, 0, NULL, NULL);
+	if (sx) {
+		sx->str = atom;
+	}
+	return sx;
 }
 
 // -----------------------------------------------------------------------
-struct st * st_arg(int type, ...)
+struct st * st_arg(struct emas_ctx *ctx, int type, ...)
 {
 	va_list ap;
 	struct st *stx, *s;
 
-	stx = st_new(type, 0, 0, NULL, NULL);
+	stx = st_new(ctx, type, 0, NULL, NULL);
 	if (!stx) return NULL;
 
 	va_start(ap, type);
@@ -167,7 +322,6 @@ struct st * st_app(struct st *t1, struct st *t2)
 		t = t->next;
 	}
 	t->next = t2;
-	t2->prev = t;
 
 	return t1;
 }
@@ -20,40 +20,69 @@
 
 #include <inttypes.h>
 
+// Node payload depends on the node type (tagged union)
 struct st {
-	int type;			// Node type (not token type!)
-						// Node may hold:
-	char *str;			//  * string
-	int64_t val;		//  * integer value
-	double flo;			//  * floating point value
-	uint16_t *data;		//  * unsigned 16-bit blob (rendered only during evaluation)
+	union {				// Node may hold:
+		int64_t val;	//  * integer value
+		double flo;		//  * floating point value
+		struct dh_elem *sym; // * symbol table entry (names, bound before evaluation)
+	};
+	union {
+		char *str;		//  * string (value above holds its length, if set)
+						//    or an interned name (not owned by the node)
+		uint16_t *data;	//  * unsigned 16-bit blob (rendered only during evaluation)
+		struct bc *code; // * compiled expression (operators)
+		struct dh_elem *ext; // * external symbol the value is relative to (ST_EXTERN)
+	};
 						//  * list of arguments:
 	struct st *args;	//     * list head
 	struct st *next;	//     * next argument
-	struct st *prev;	//     * previous argument
 	struct st *last;	//     * list tail
-						// Also, we store location of a node related token in source file (to reference errors)
-	char *loc_file;		//  * source file (pointer to a file dictionary)
-	int loc_line;		//  * source line
-	int loc_col;		//  * source column
+	uint32_t loc;		// Location of a node related token in source file (to reference errors),
+						// index in the context location table
 						// Upon evaluation, nodes get additional properties:
 	int ic;				//  * IC at which node is to be rendered
 	int size;			//  * size of data that node actually holds
-	int flags;			//  * set if node holds object-relative value
+	int16_t type;		// Node type (not token type!)
+	uint16_t flags;		//  * set if node holds object-relative value
+};
+
+// Source location of a node
+struct st_loc {
+	char *file;			//  * source file (pointer to a file dictionary)
+	int line;			//  * source line
+	int col;			//  * source column
+	char *stmt_file;	//  * where the statement the node belongs to starts
+	int stmt_line;		//    (for listings, errors point at the node)
 };
 
 enum st_flags {
 	ST_NONE		= 0,
 	ST_RELATIVE	= 1 << 0,
+	ST_DATA		= 1 << 1,	// data is written during evaluation (node clones need their own copy)
+	ST_SIGNED	= 1 << 2,	// data is followed by a bitmap of words given as negative values
+	ST_EXTERN	= 1 << 3,	// value is relative to a symbol defined in another module
 };
 
-struct st * st_copy(struct st *t);
-void st_drop(struct st *stx);
-struct st * st_int(int type, int64_t val);
-struct st * st_float(int type, double flo);
-struct st * st_str(int type, char *str);
-struct st * st_strval(int type, char *str, int val);
-struct st * st_arg(int type, ...);
+struct emas_ctx;
+struct dh_elem;
+struct YYLTYPE;
+struct bc;
+
+int st_data_words(struct st *t);
+struct st * st_copy(struct emas_ctx *ctx, struct st *t);
+struct st * st_clone(struct emas_ctx *ctx, struct st *t);
+struct st_loc * st_loc(struct emas_ctx *ctx, struct st *t);
+void st_loc_set(struct emas_ctx *ctx, struct st *t, struct YYLTYPE *lloc);
+void st_loc_stmt(struct emas_ctx *ctx, struct st *t, struct st *stmt);
+void st_loc_reset(struct emas_ctx *ctx);
+void st_drop(struct emas_ctx *ctx, struct st *stx);
+struct st * st_int(struct emas_ctx *ctx, int type, int64_t val);
+struct st * st_float(struct emas_ctx *ctx, int type, double flo);
+struct st * st_str(struct emas_ctx *ctx, int type, char *str);
+struct st * st_strval(struct emas_ctx *ctx, int type, char *str, int val);
+struct st * st_atom(struct emas_ctx *ctx, int type, char *atom);
+struct st * st_arg(struct emas_ctx *ctx, int type, ...);
 struct st * st_arg_app(struct st *stx, struct st *app_first);
 struct st * st_app(struct st *t1, struct st *t2);
 
@@ -19,190 +19,1460 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#ifdef _WIN32
-#include <winsock2.h>
-#else
-#include <arpa/inet.h>
-#endif
+#include <stdint.h>
 
 #include "prog.h"
 #include "st.h"
+#include "ctx.h"
+#include "obj.h"
+#include "seg.h"
+#include "fmt.h"
+#include "map.h"
+#include "lines.h"
 
-#define MEM_MAX 64 * 1024
+// raw output is buffered in chunks of this many words. Gaps that large
+// are not written, but skipped over (making holes in the file).
+#define RAW_CHUNK 4096
 
-uint16_t image[MEM_MAX];
-int rel_count;
-int icmax = -1;
+// -----------------------------------------------------------------------
+// Get value of a blob word, negative if it was given that way
+static int blob_value(struct st *t, int i)
+{
+	if ((t->flags & ST_SIGNED) && (t->data[t->size + i/16] & (1 << (i%16)))) {
+		return (int16_t) t->data[i];
+	}
+	return t->data[i];
+}
 
 // -----------------------------------------------------------------------
-// convert an integer to formatted string with its binary representation
-static char * int2binf(char *format, uint64_t value, int size)
+static void debug_print(struct fmt *o, uint16_t addr, uint16_t data, int64_t value)
 {
-	char *i = format;
-	char *buf = malloc(strlen(format)+1);
-	char *o = buf;
+	fmt_str(o, "@ 0x");
+	fmt_hex(o, addr, 4);
+	fmt_str(o, " : 0x");
+	fmt_hex(o, data, 4);
+	fmt_str(o, "  /  ");
+	fmt_bin(o, data, "3 3 1 3 3 3");
+	fmt_str(o, "  /  ");
+	fmt_dec(o, value, 0);
+	fmt_char(o, '\n');
+}
 
-	size--;
+// -----------------------------------------------------------------------
+static void unresolved_print(struct fmt *o, uint16_t addr)
+{
+	fmt_str(o, "@ 0x");
+	fmt_hex(o, addr, 4);
+	fmt_str(o, " : unresolved\n");
+}
 
-	while (*i) {
-		switch (*i) {
-			case '.':
-				if (size >= 0) {
-					*o = (value >> size) & 1 ? '1' : '0';
-					size--;
-				} else {
-					*o = '?';
-				}
-				break;
-			default:
-				*o = *i;
-				break;
-		}
-		o++;
-		i++;
+// -----------------------------------------------------------------------
+// Finish a text writer: flush the output and report if anything failed
+static int text_done(struct emas_ctx *ctx, struct fmt *o)
+{
+	if (fmt_destroy(o)) {
+		aaerror(ctx, NULL, "Write failed");
+		return 1;
 	}
-	*o = '\0';
-	return buf;
+
+	return 0;
 }
 
 // -----------------------------------------------------------------------
-int writer_debug(struct st *prog, FILE *f)
+int writer_debug(struct emas_ctx *ctx, FILE *f)
 {
-	struct st *t = prog->args;
-	char *bin;
+	AADEBUG(ctx, "==== DEBUG writer ================================");
+
+	struct fmt *o = fmt_create(f);
+	if (!o) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the output buffer");
+		return 1;
+	}
 
-	AADEBUG("==== DEBUG writer ================================");
-	while (t) {
+	for (int n=0 ; n<ctx->stmt_count ; n++) {
+		struct st *t = ctx->stmts[n];
 		switch (t->type) {
 			case N_INT:
-				bin = int2binf("... ... . ... ... ...", t->val, 16);
-				fprintf(f, "@ 0x%04x : 0x%04x  /  %s  /  %lli\n", t->ic, (uint16_t) t->val, bin, (long long int) t->val);
-				free(bin);
+				debug_print(o, t->ic, t->val, t->val);
 				break;
 			case N_BLOB:
 				for (int i=0 ; i<t->size ; i++) {
-					char *bin = int2binf("... ... . ... ... ...", t->data[i], 16);
-					fprintf(f, "@ 0x%04x : 0x%04x  /  %s  /  %i\n", t->ic+i, (uint16_t) t->data[i], bin, t->data[i]);
-					free(bin);
+					debug_print(o, t->ic+i, t->data[i], blob_value(t, i));
+				}
+				break;
+			case N_FILL:
+				for (int i=0 ; i<t->size ; i++) {
+					debug_print(o, t->ic+i, t->val, (uint16_t) t->val);
 				}
 				break;
 			case N_NONE:
 				break;
 			default:
-				fprintf(f, "@ 0x%04x : unresolved\n", t->ic);
+				unresolved_print(o, t->ic);
 				break;
 		}
-		t = t->next;
 	}
-	return 0;
+
+	return text_done(ctx, o);
 }
 
 // -----------------------------------------------------------------------
-static void keys_print(FILE *f, uint16_t addr, uint16_t data)
+static void keys_print(struct fmt *o, uint16_t addr, uint16_t data)
 {
-	char *bin;
-	bin = int2binf(".... .... .... ....", data, 16);
-	fprintf(f, "%4i: %06o   %s   ", addr, data, bin);
-	free(bin);
+	fmt_dec(o, addr, 4);
+	fmt_str(o, ": ");
+	fmt_oct(o, data, 6);
+	fmt_str(o, "   ");
+	fmt_bin(o, data, "4 4 4 4");
+	fmt_str(o, "   ");
 	int first = 1;
 	for (int i=0; i<16 ; i++) {
 		if ((data & (1<<(15-i)))) {
 			if (!first) {
-				fprintf(f, ", %i", i);
-			} else {
-				fprintf(f, "%i", i);
+				fmt_str(o, ", ");
 			}
+			fmt_dec(o, i, 0);
 			first = 0;
 		}
 	}
-	fprintf(f, "\n");
+	fmt_char(o, '\n');
 }
 
 // -----------------------------------------------------------------------
-int writer_keys(struct st *prog, FILE *f)
+int writer_keys(struct emas_ctx *ctx, FILE *f)
 {
-	struct st *t = prog->args;
+	AADEBUG(ctx, "==== KEYS writer ================================");
+
+	struct fmt *o = fmt_create(f);
+	if (!o) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the output buffer");
+		return 1;
+	}
 
-	AADEBUG("==== KEYS writer ================================");
-	fprintf(f, "addr: oct      bin                   keys\n");
-	fprintf(f, "-------------------------------------------------------------------\n");
-	while (t) {
+	fmt_str(o, "addr: oct      bin                   keys\n");
+	fmt_str(o, "-------------------------------------------------------------------\n");
+	for (int n=0 ; n<ctx->stmt_count ; n++) {
+		struct st *t = ctx->stmts[n];
 		switch (t->type) {
 			case N_INT:
-				keys_print(f, t->ic, t->val);
+				keys_print(o, t->ic, t->val);
 				break;
 			case N_BLOB:
 				for (int i=0 ; i<t->size ; i++) {
-					keys_print(f, t->ic+i, t->data[i]);
+					keys_print(o, t->ic+i, t->data[i]);
+				}
+				break;
+			case N_FILL:
+				for (int i=0 ; i<t->size ; i++) {
+					keys_print(o, t->ic+i, t->val);
 				}
 				break;
 			case N_NONE:
 				break;
 			default:
-				fprintf(f, "@ 0x%04x : unresolved\n", t->ic);
+				unresolved_print(o, t->ic);
 				break;
 		}
-		t = t->next;
 	}
-	return 0;
+
+	return text_done(ctx, o);
 }
 
+// Source file shown in a listing
+struct lst_file {
+	char *name;			// file name, as in node locations
+	char *text;			// file contents (NULL if the file cannot be read)
+	int *lines;			// offsets of line beginnings, plus the end of text
+	int line_count;
+	int printed;		// last line already listed
+};
+
+// Listing writer state
+struct lst {
+	struct emas_ctx *ctx;
+	struct fmt *o;
+	struct lst_file *files;
+	int file_count;
+	struct lst_file *cur;	// file the last listed line comes from
+};
+
+// width of the address and data columns, source lines go after those
+#define LST_DATA_COLS 39
+
 // -----------------------------------------------------------------------
-static void img_put(struct st *t)
+static char * lst_read(FILE *f, int *len)
 {
-	switch (t->type) {
-		case N_INT:
-			if (t->ic > icmax) icmax = t->ic;
-			image[t->ic] = t->val;
-			break;
-		case N_BLOB:
-			for (int i=0 ; i<t->size ; i++) {
-				if (t->ic+i > icmax) icmax = t->ic+i;
-				image[t->ic+i] = t->data[i];
+	char *buf = NULL;
+	int size = 0;
+	int res;
+
+	*len = 0;
+	do {
+		if (*len == size) {
+			size = size ? size * 2 : 4096;
+			char *nbuf = realloc(buf, size);
+			if (!nbuf) {
+				free(buf);
+				return NULL;
 			}
-			break;
+			buf = nbuf;
+		}
+		res = fread(buf + *len, 1, size - *len, f);
+		*len += res;
+	} while (res > 0);
+
+	return buf;
+}
+
+// -----------------------------------------------------------------------
+// Read the source file and index its lines
+static void lst_load(struct lst *l, struct lst_file *file)
+{
+	struct emas_ctx *ctx = l->ctx;
+	FILE *f;
+	int len;
+
+	// main source is opened just like the assembler opened it,
+	// everything else came from include directories
+	if (ctx->source && !strcmp(file->name, ctx->source)) {
+		char *path = ctx_path(ctx, file->name);
+		f = path ? fopen(path, "r") : NULL;
+		free(path);
+	} else {
+		f = inc_open(ctx, file->name);
 	}
+	if (!f) {
+		return;
+	}
+
+	file->text = lst_read(f, &len);
+	fclose(f);
+	if (!file->text) {
+		return;
+	}
+
+	int count = 0;
+	for (int i=0 ; i<len ; i++) {
+		if (file->text[i] == '\n') count++;
+	}
+	if (len && (file->text[len-1] != '\n')) count++;
+
+	file->lines = malloc((count+1) * sizeof(int));
+	if (!file->lines) {
+		free(file->text);
+		file->text = NULL;
+		return;
+	}
+
+	int n = 0;
+	file->lines[n++] = 0;
+	for (int i=0 ; i<len ; i++) {
+		if ((file->text[i] == '\n') && (n < count)) {
+			file->lines[n++] = i+1;
+		}
+	}
+	file->lines[count] = len;
+	file->line_count = count;
 }
 
 // -----------------------------------------------------------------------
-int writer_raw(struct st *prog, FILE *f)
+// Get the source file, loading it on first use
+static struct lst_file * lst_file(struct lst *l, char *name)
 {
-	int res;
-	struct st *t;
-	int pos;
+	for (int i=0 ; i<l->file_count ; i++) {
+		if (!strcmp(l->files[i].name, name)) {
+			return l->files + i;
+		}
+	}
+
+	struct lst_file *files = realloc(l->files, (l->file_count+1) * sizeof(struct lst_file));
+	if (!files) {
+		return NULL;
+	}
+	l->files = files;
 
-	AADEBUG("==== RAW writer ================================");
-	t = prog->args;
-	while (t) {
+	struct lst_file *file = files + l->file_count++;
+	memset(file, 0, sizeof(struct lst_file));
+	file->name = name;
+	lst_load(l, file);
+
+	return file;
+}
+
+// -----------------------------------------------------------------------
+static void lst_text(struct lst *l, struct lst_file *file, int line)
+{
+	int start = file->lines[line-1];
+	int end = file->lines[line];
+
+	while ((end > start) && ((file->text[end-1] == '\n') || (file->text[end-1] == '\r'))) {
+		end--;
+	}
+
+	fmt_str(l->o, "  ");
+	fmt_dec(l->o, line, 5);
+	fmt_str(l->o, "  ");
+	fmt_strn(l->o, file->text + start, end - start);
+}
+
+// -----------------------------------------------------------------------
+// List source lines up to (but not including) the given one
+static void lst_upto(struct lst *l, struct lst_file *file, int line)
+{
+	if (l->cur != file) {
+		fmt_str(l->o, "---- ");
+		fmt_str(l->o, file->name);
+		fmt_char(l->o, '\n');
+		l->cur = file;
+	}
+
+	while (file->printed < line-1) {
+		file->printed++;
+		fmt_fill(l->o, ' ', LST_DATA_COLS);
+		lst_text(l, file, file->printed);
+		fmt_char(l->o, '\n');
+	}
+}
+
+// -----------------------------------------------------------------------
+// Get source file of a statement, if its line has not been listed yet
+static struct lst_file * lst_source(struct lst *l, struct st *t)
+{
+	struct st_loc *loc = st_loc(l->ctx, t);
+
+	if (!loc->stmt_file) {
+		return NULL;
+	}
+
+	struct lst_file *file = lst_file(l, loc->stmt_file);
+	if (!file || !file->text || (loc->stmt_line <= file->printed) || (loc->stmt_line > file->line_count)) {
+		return NULL;
+	}
+
+	lst_upto(l, file, loc->stmt_line);
+
+	return file;
+}
+
+// -----------------------------------------------------------------------
+static void lst_word(struct fmt *o, uint16_t addr, uint16_t data)
+{
+	fmt_hex(o, addr, 4);
+	fmt_str(o, ": ");
+	fmt_hex(o, data, 4);
+	fmt_char(o, ' ');
+	fmt_oct(o, data, 6);
+	fmt_char(o, ' ');
+	fmt_bin(o, data, "3 3 1 3 3 3");
+}
+
+// -----------------------------------------------------------------------
+// Finish a listing row with the statement source line (if there is one)
+static void lst_end(struct lst *l, struct lst_file *file, struct st *t)
+{
+	if (file) {
+		int line = st_loc(l->ctx, t)->stmt_line;
+		lst_text(l, file, line);
+		file->printed = line;
+	}
+	fmt_char(l->o, '\n');
+}
+
+// -----------------------------------------------------------------------
+// Program listing: address, word in hex, octal and binary,
+// followed by the source line the word comes from
+int writer_listing(struct emas_ctx *ctx, FILE *f)
+{
+	AADEBUG(ctx, "==== LISTING writer ================================");
+
+	struct lst l = { ctx, fmt_create(f), NULL, 0, NULL };
+	if (!l.o) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the output buffer");
+		return 1;
+	}
+
+	// main source goes first, even if it produces no code
+	if (ctx->source) {
+		lst_file(&l, ctx->source);
+	}
+
+	for (int n=0 ; n<ctx->stmt_count ; n++) {
+		struct st *t = ctx->stmts[n];
+		struct lst_file *file;
 		switch (t->type) {
 			case N_INT:
+				file = lst_source(&l, t);
+				lst_word(l.o, t->ic, t->val);
+				lst_end(&l, file, t);
+				break;
 			case N_BLOB:
-				img_put(t);
+				file = lst_source(&l, t);
+				for (int i=0 ; i<t->size ; i++) {
+					lst_word(l.o, t->ic+i, t->data[i]);
+					lst_end(&l, i ? NULL : file, t);
+				}
+				break;
+			case N_FILL:
+				if (t->size <= 0) break;
+				file = lst_source(&l, t);
+				lst_word(l.o, t->ic, t->val);
+				lst_end(&l, file, t);
+				if (t->size > 1) {
+					fmt_str(l.o, "      (");
+					fmt_dec(l.o, t->size, 0);
+					fmt_str(l.o, " words)\n");
+				}
 				break;
 			case N_NONE:
 				break;
 			default:
-				aaerror(t, "Relocation not possible for raw output");
+				file = lst_source(&l, t);
+				fmt_hex(l.o, t->ic, 4);
+				fmt_str(l.o, ": unresolved");
+				fmt_fill(l.o, ' ', LST_DATA_COLS - 16);
+				lst_end(&l, file, t);
+				break;
+		}
+	}
+
+	// source lines after the last statement
+	for (int i=0 ; i<l.file_count ; i++) {
+		struct lst_file *file = l.files + i;
+		if (file->text && (file->printed < file->line_count)) {
+			lst_upto(&l, file, file->line_count+1);
+		}
+		free(file->text);
+		free(file->lines);
+	}
+	free(l.files);
+
+	return text_done(ctx, l.o);
+}
+
+// -----------------------------------------------------------------------
+// Raw output state. Program is written in IC order: statements
+// are already sorted this way, as IC can only go forward.
+struct raw_out {
+	FILE *f;
+	int seekable;
+	int ic;			// IC of the next word to be output
+	int len;		// words in the buffer
+	uint8_t buf[2*RAW_CHUNK];
+};
+
+// -----------------------------------------------------------------------
+static int raw_flush(struct raw_out *o)
+{
+	if (o->len && (fwrite(o->buf, 2, o->len, o->f) != (size_t) o->len)) {
+		return -1;
+	}
+	o->len = 0;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Output words in big-endian byte order (loop is simple enough
+// for the compiler to vectorize it)
+static int raw_put(struct raw_out *o, const uint16_t *data, int count)
+{
+	while (count > 0) {
+		int n = RAW_CHUNK - o->len;
+		if (n > count) n = count;
+		uint8_t *b = o->buf + 2*o->len;
+		for (int i=0 ; i<n ; i++) {
+			b[2*i] = data[i] >> 8;
+			b[2*i+1] = data[i];
+		}
+		o->len += n;
+		o->ic += n;
+		data += n;
+		count -= n;
+		if ((o->len == RAW_CHUNK) && raw_flush(o)) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int raw_fill(struct raw_out *o, uint16_t value, int count)
+{
+	while (count > 0) {
+		int n = RAW_CHUNK - o->len;
+		if (n > count) n = count;
+		uint8_t *b = o->buf + 2*o->len;
+		for (int i=0 ; i<n ; i++) {
+			b[2*i] = value >> 8;
+			b[2*i+1] = value;
+		}
+		o->len += n;
+		o->ic += n;
+		count -= n;
+		if ((o->len == RAW_CHUNK) && raw_flush(o)) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int raw_put32(struct raw_out *o, uint32_t value)
+{
+	uint16_t words[2] = { value >> 16, value & 0xffff };
+
+	return raw_put(o, words, 2);
+}
+
+// -----------------------------------------------------------------------
+// Move output forward to the given IC. Skipped words read as zeros:
+// large gaps become holes if the file can seek, small ones are written.
+static int raw_skip(struct raw_out *o, int ic)
+{
+	if (o->seekable && (ic - o->ic >= RAW_CHUNK)) {
+		if (raw_flush(o)) {
+			return -1;
+		}
+		if (!fseek(o->f, 2L * (ic - o->ic), SEEK_CUR)) {
+			o->ic = ic;
+			return 0;
+		}
+		o->seekable = 0;
+	}
+
+	return raw_fill(o, 0, ic - o->ic);
+}
+
+// -----------------------------------------------------------------------
+int writer_raw(struct emas_ctx *ctx, FILE *f)
+{
+	int end = 0; // IC just after the last word of the program
+	int res = 0;
+
+	AADEBUG(ctx, "==== RAW writer ================================");
+
+	struct raw_out *o = malloc(sizeof(struct raw_out));
+	if (!o) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the output buffer");
+		return 1;
+	}
+	o->f = f;
+	o->seekable = !fseek(f, 0, SEEK_CUR);
+	o->ic = 0;
+	o->len = 0;
+
+	for (int n=0 ; n<ctx->stmt_count ; n++) {
+		struct st *t = ctx->stmts[n];
+		uint16_t word;
+		switch (t->type) {
+			case N_INT:
+				word = t->val;
+				res = raw_skip(o, t->ic) || raw_put(o, &word, 1);
+				break;
+			case N_BLOB:
+				res = raw_skip(o, t->ic) || raw_put(o, t->data, t->size);
+				break;
+			case N_FILL:
+				if (t->size <= 0) break;
+				// zeros are treated as a gap
+				if ((uint16_t) t->val) {
+					res = raw_skip(o, t->ic) || raw_fill(o, t->val, t->size);
+				}
+				break;
+			case N_NONE:
+				continue;
+			default:
+				aaerror(ctx, t, "Relocation not possible for raw output");
+				free(o);
 				return 1;
 		}
-		t = t->next;
+		if (res) break;
+		if (t->ic + t->size > end) {
+			end = t->ic + t->size;
+		}
+	}
+
+	// a gap at the end still needs to be there
+	if (!res && (end > o->ic)) {
+		uint16_t zero = 0;
+		res = raw_skip(o, end-1) || raw_put(o, &zero, 1);
 	}
 
-	pos = icmax;
-	while (pos >= 0) {
-		image[pos] = htons(image[pos]);
-		pos--;
+	if (res || raw_flush(o)) {
+		aaerror(ctx, NULL, "Write failed");
+		free(o);
+		return 1;
 	}
 
-	if (icmax >= 0) {
-		res = fwrite(image, 2, icmax+1, f);
-		if (res < 0) {
-			aaerror(NULL, "Write failed");
+	free(o);
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Check if the statement starts a chunk: a run of contiguous code
+// and data, or a fill
+static int chunk_start(struct st *t)
+{
+	switch (t->type) {
+		case N_INT:
 			return 1;
+		case N_BLOB:
+		case N_FILL:
+			return t->size > 0;
+		default:
+			return 0;
+	}
+}
+
+// -----------------------------------------------------------------------
+// Find the end of a chunk starting with statement 'n'. Returns index
+// of the first statement past the chunk, chunk length goes to 'len'.
+static int chunk_end(struct emas_ctx *ctx, int n, int *len)
+{
+	struct st *t = ctx->stmts[n];
+	int start = t->ic;
+	int end = start;
+
+	if (t->type == N_FILL) {
+		*len = t->size;
+		return n+1;
+	}
+
+	for ( ; n<ctx->stmt_count ; n++) {
+		t = ctx->stmts[n];
+		if (t->type == N_NONE) continue;
+		if (((t->type != N_INT) && (t->type != N_BLOB)) || (t->ic != end)) break;
+		end += t->size;
+	}
+
+	*len = end - start;
+	return n;
+}
+
+// -----------------------------------------------------------------------
+// Output contents of a chunk (statements from 'n' up to 'next').
+// Fills have none.
+static int chunk_data(struct emas_ctx *ctx, struct raw_out *o, int n, int next)
+{
+	for ( ; n<next ; n++) {
+		struct st *t = ctx->stmts[n];
+		uint16_t word = t->val;
+		if ((t->type == N_INT) && raw_put(o, &word, 1)) {
+			return -1;
+		} else if ((t->type == N_BLOB) && raw_put(o, t->data, t->size)) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Write a segmented image: segment table first, then the data
+int writer_seg(struct emas_ctx *ctx, FILE *f)
+{
+	uint32_t count = 0;
+	int len;
+	int res;
+
+	AADEBUG(ctx, "==== SEG writer ================================");
+
+	for (int n=0 ; n<ctx->stmt_count ; ) {
+		if (chunk_start(ctx->stmts[n])) {
+			count++;
+			n = chunk_end(ctx, n, &len);
+		} else {
+			n++;
+		}
+	}
+
+	struct raw_out *o = malloc(sizeof(struct raw_out));
+	if (!o) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the output buffer");
+		return 1;
+	}
+	o->f = f;
+	o->seekable = 0;
+	o->ic = 0;
+	o->len = 0;
+
+	uint16_t head[6] = {
+		SEG_MAGIC_HI, SEG_MAGIC_LO, SEG_VERSION,
+		ctx->entry ? SEG_ENTRY : 0,
+		(ctx->cpu & CPU_MX16) ? CPU_MX16 : CPU_MERA400,
+		ctx->entry ? ctx->entry->val : 0
+	};
+	res = raw_put(o, head, 6) || raw_put32(o, count);
+
+	uint32_t offset = SEG_HEADER_WORDS + count * SEG_ENTRY_WORDS;
+	for (int n=0 ; !res && (n<ctx->stmt_count) ; ) {
+		struct st *t = ctx->stmts[n];
+		if (!chunk_start(t)) {
+			n++;
+			continue;
+		}
+		n = chunk_end(ctx, n, &len);
+		uint16_t seg[2] = { 0, 0 };
+		uint32_t data = offset;
+		if (t->type == N_FILL) {
+			seg[0] = SEG_FILL;
+			seg[1] = t->val;
+			data = 0;
+		} else {
+			offset += len;
+		}
+		res = raw_put32(o, t->ic) || raw_put32(o, len) || raw_put(o, seg, 2) || raw_put32(o, data);
+	}
+
+	for (int n=0 ; !res && (n<ctx->stmt_count) ; ) {
+		if (!chunk_start(ctx->stmts[n])) {
+			n++;
+			continue;
+		}
+		int next = chunk_end(ctx, n, &len);
+		res = chunk_data(ctx, o, n, next);
+		n = next;
+	}
+
+	if (res || raw_flush(o)) {
+		aaerror(ctx, NULL, "Write failed");
+		free(o);
+		return 1;
+	}
+
+	free(o);
+	return 0;
+}
+
+// Global symbols of a relocatable module
+struct obj_syms {
+	struct dh_elem **elems;	// sorted by name (symbol table order)
+	struct obj_sym_idx *idx;	// sorted by element address (for lookups)
+	int count;
+	int cap;
+};
+
+struct obj_sym_idx {
+	struct dh_elem *s;
+	uint32_t index;
+};
+
+// -----------------------------------------------------------------------
+static int obj_sym_name_cmp(const void *a, const void *b)
+{
+	return strcmp((*(struct dh_elem**) a)->name, (*(struct dh_elem**) b)->name);
+}
+
+// -----------------------------------------------------------------------
+static int obj_sym_idx_cmp(const void *a, const void *b)
+{
+	const struct dh_elem *sa = ((struct obj_sym_idx*) a)->s;
+	const struct dh_elem *sb = ((struct obj_sym_idx*) b)->s;
+
+	return (sa > sb) - (sa < sb);
+}
+
+// -----------------------------------------------------------------------
+// Collect global symbols from the table (and tables of local names)
+static int obj_syms_collect(struct obj_syms *os, struct dh_table *dh)
+{
+	for (unsigned i=0 ; i<dh->size ; i++) {
+		struct dh_elem *s = dh->slots[i].elem;
+		if (!s) continue;
+		if (s->locals && obj_syms_collect(os, s->locals)) {
+			return -1;
+		}
+		if (!(s->type & SYM_GLOBAL)) continue;
+		if (os->count >= os->cap) {
+			int cap = os->cap ? os->cap * 2 : 64;
+			struct dh_elem **e = realloc(os->elems, cap * sizeof(struct dh_elem*));
+			if (!e) {
+				return -1;
+			}
+			os->elems = e;
+			os->cap = cap;
+		}
+		os->elems[os->count++] = s;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int obj_syms_build(struct obj_syms *os, struct emas_ctx *ctx)
+{
+	memset(os, 0, sizeof(struct obj_syms));
+
+	if (obj_syms_collect(os, ctx->sym)) {
+		return -1;
+	}
+
+	if (!os->count) {
+		return 0;
+	}
+
+	qsort(os->elems, os->count, sizeof(struct dh_elem*), obj_sym_name_cmp);
+
+	os->idx = malloc(os->count * sizeof(struct obj_sym_idx));
+	if (!os->idx) {
+		return -1;
+	}
+	for (int i=0 ; i<os->count ; i++) {
+		os->idx[i].s = os->elems[i];
+		os->idx[i].index = i;
+	}
+	qsort(os->idx, os->count, sizeof(struct obj_sym_idx), obj_sym_idx_cmp);
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static uint32_t obj_sym_index(struct obj_syms *os, struct dh_elem *s)
+{
+	struct obj_sym_idx key = { s, 0 };
+	struct obj_sym_idx *i = bsearch(&key, os->idx, os->count, sizeof(struct obj_sym_idx), obj_sym_idx_cmp);
+	assert(i);
+
+	return i->index;
+}
+
+// -----------------------------------------------------------------------
+static int obj_write_chunks(struct emas_ctx *ctx, struct raw_out *o)
+{
+	int len;
+
+	for (int n=0 ; n<ctx->stmt_count ; ) {
+		struct st *t = ctx->stmts[n];
+		if (!chunk_start(t)) {
+			n++;
+			continue;
+		}
+		int next = chunk_end(ctx, n, &len);
+		uint16_t head[2] = { 0, 0 };
+		if (t->type == N_FILL) {
+			head[0] = OBJ_CHUNK_FILL;
+			head[1] = t->val;
+		}
+		if (raw_put32(o, t->ic) || raw_put32(o, len) || raw_put(o, head, 2) || chunk_data(ctx, o, n, next)) {
+			return -1;
+		}
+		n = next;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int obj_write_syms(struct emas_ctx *ctx, struct raw_out *o, struct obj_syms *os)
+{
+	for (int i=0 ; i<os->count ; i++) {
+		struct dh_elem *s = os->elems[i];
+		uint16_t head[3] = { OBJ_SYM_IMPORT, 0, strlen(s->name) };
+		if (!(s->type & SYM_UNDEFINED)) {
+			if (!s->t || (s->t->type != N_INT) || (s->t->flags & ST_EXTERN)) {
+				aaerror(ctx, s->t, "Symbol '%s' cannot be exported", s->name);
+				return 1;
+			}
+			head[0] = OBJ_SYM_EXPORT | ((s->t->flags & ST_RELATIVE) ? OBJ_SYM_RELATIVE : 0);
+			head[1] = s->t->val;
+		}
+		if (raw_put(o, head, 3)) {
+			return -1;
+		}
+		for (int c=0 ; c<head[2] ; c+=2) {
+			uint16_t word = (uint8_t) s->name[c] << 8;
+			if (c+1 < head[2]) {
+				word |= (uint8_t) s->name[c+1];
+			}
+			if (raw_put(o, &word, 1)) {
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int obj_write_relocs(struct emas_ctx *ctx, struct raw_out *o, struct obj_syms *os)
+{
+	for (int n=0 ; n<ctx->stmt_count ; n++) {
+		struct st *t = ctx->stmts[n];
+		if (t->type != N_BLOB) continue;
+		for (struct st *e=t->args ; e ; e=e->next) {
+			uint32_t sym = (e->flags & ST_EXTERN) ? obj_sym_index(os, e->ext) : OBJ_SYM_SECTION;
+			if (raw_put32(o, t->ic + e->ic) || raw_put32(o, sym) || raw_put32(o, (uint32_t) e->val)) {
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Write a relocatable module. Symbol table is only read here.
+int writer_obj(struct emas_ctx *ctx, FILE *f)
+{
+	struct obj_syms os;
+	uint32_t size = 0;
+	uint32_t chunks = 0;
+	uint32_t relocs = 0;
+	int len;
+	int res;
+
+	AADEBUG(ctx, "==== OBJ writer ================================");
+
+	for (int n=0 ; n<ctx->stmt_count ; n++) {
+		struct st *t = ctx->stmts[n];
+		if (t->ic + t->size > size) {
+			size = t->ic + t->size;
+		}
+		if (t->type == N_BLOB) {
+			for (struct st *e=t->args ; e ; e=e->next) {
+				relocs++;
+			}
+		}
+	}
+
+	for (int n=0 ; n<ctx->stmt_count ; ) {
+		struct st *t = ctx->stmts[n];
+		if (chunk_start(t)) {
+			chunks++;
+			n = chunk_end(ctx, n, &len);
+		} else {
+			n++;
+		}
+	}
+
+	if (obj_syms_build(&os, ctx)) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the symbol table");
+		free(os.elems);
+		free(os.idx);
+		return 1;
+	}
+
+	struct raw_out *o = malloc(sizeof(struct raw_out));
+	if (!o) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the output buffer");
+		free(os.elems);
+		free(os.idx);
+		return 1;
+	}
+	o->f = f;
+	o->seekable = 0;
+	o->ic = 0;
+	o->len = 0;
+
+	uint16_t head[4] = { OBJ_MAGIC_HI, OBJ_MAGIC_LO, OBJ_VERSION, (ctx->cpu & CPU_MX16) ? CPU_MX16 : CPU_MERA400 };
+	res = raw_put(o, head, 4) || raw_put32(o, size) || raw_put32(o, chunks) || raw_put32(o, os.count) || raw_put32(o, relocs);
+	if (!res) {
+		res = obj_write_chunks(ctx, o);
+	}
+	if (!res) {
+		res = obj_write_syms(ctx, o, &os);
+	}
+	if (!res) {
+		res = obj_write_relocs(ctx, o, &os);
+	}
+
+	free(os.elems);
+	free(os.idx);
+
+	if (res > 0) {
+		free(o);
+		return 1;
+	}
+
+	if (res || raw_flush(o)) {
+		aaerror(ctx, NULL, "Write failed");
+		free(o);
+		return 1;
+	}
+
+	free(o);
+	return 0;
+}
+
+// Source files (names are atoms) referenced by an output
+struct file_list {
+	char **names;
+	int count;
+};
+
+// -----------------------------------------------------------------------
+// Get index of the file on the list, add it if it's not there yet
+static int file_index(struct file_list *fl, char *name)
+{
+	// lookups usually come for the same few files
+	for (int i=fl->count-1 ; i>=0 ; i--) {
+		if (fl->names[i] == name) {
+			return i;
+		}
+	}
+
+	char **names = realloc(fl->names, (fl->count+1) * sizeof(char*));
+	if (!names) {
+		return -1;
+	}
+	fl->names = names;
+	fl->names[fl->count] = name;
+
+	return fl->count++;
+}
+
+// Bytes packed into output words, two in a word
+struct raw_bytes {
+	struct raw_out *o;
+	uint16_t word;
+	int pos;
+};
+
+// -----------------------------------------------------------------------
+static int raw_byte(struct raw_bytes *b, uint8_t c)
+{
+	if (b->pos++ & 1) {
+		b->word |= c;
+		return raw_put(b->o, &b->word, 1);
+	}
+
+	b->word = c << 8;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Write a zero-terminated string
+static int raw_str(struct raw_bytes *b, const char *s)
+{
+	do {
+		if (raw_byte(b, *s)) {
+			return -1;
+		}
+	} while (*s++);
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Pad the last word with zero
+static int raw_bytes_end(struct raw_bytes *b)
+{
+	if (b->pos & 1) {
+		return raw_byte(b, 0);
+	}
+
+	return 0;
+}
+
+// Symbol map entry
+struct map_sym {
+	struct dh_elem *s;
+	int32_t value;
+	uint16_t flags;
+	uint16_t file;
+	uint32_t line;
+	uint32_t name;		// name position in the string table
+};
+
+// Symbol map being built
+struct map {
+	struct emas_ctx *ctx;
+	struct map_sym *syms;
+	int count;
+	int cap;
+	struct file_list files;
+};
+
+// -----------------------------------------------------------------------
+// Collect defined symbols from the table (and tables of local names)
+static int map_collect(struct map *m, struct dh_table *dh)
+{
+	for (unsigned i=0 ; i<dh->size ; i++) {
+		struct dh_elem *s = dh->slots[i].elem;
+		if (!s) continue;
+		if (s->locals && map_collect(m, s->locals)) {
+			return -1;
+		}
+		// only integer values can be looked up,
+		// values relative to other modules are not known yet
+		if ((s->type & SYM_UNDEFINED) || !s->t || (s->t->type != N_INT) || (s->t->flags & ST_EXTERN)) continue;
+		if (m->count >= m->cap) {
+			int cap = m->cap ? m->cap * 2 : 256;
+			struct map_sym *syms = realloc(m->syms, cap * sizeof(struct map_sym));
+			if (!syms) {
+				return -1;
+			}
+			m->syms = syms;
+			m->cap = cap;
+		}
+		struct map_sym *ms = m->syms + m->count++;
+		struct st_loc *loc = st_loc(m->ctx, s->t);
+		ms->s = s;
+		ms->value = s->t->val;
+		ms->flags = 0;
+		if (s->t->flags & ST_RELATIVE) ms->flags |= MAP_SYM_RELATIVE;
+		if (s->type & SYM_GLOBAL) ms->flags |= MAP_SYM_GLOBAL;
+		if (!(s->type & SYM_CONST)) ms->flags |= MAP_SYM_VARIABLE;
+		ms->line = loc->stmt_line;
+		if (loc->stmt_file) {
+			int file = file_index(&m->files, loc->stmt_file);
+			if (file < 0) {
+				return -1;
+			}
+			ms->file = file;
+		} else {
+			ms->file = MAP_NO_FILE;
 		}
 	}
 
 	return 0;
 }
 
+// -----------------------------------------------------------------------
+static int map_sym_value_cmp(const void *a, const void *b)
+{
+	const struct map_sym *sa = a;
+	const struct map_sym *sb = b;
+
+	if (sa->value != sb->value) {
+		return (sa->value > sb->value) - (sa->value < sb->value);
+	}
+
+	return strcmp(sa->s->name, sb->s->name);
+}
+
+// -----------------------------------------------------------------------
+static int map_sym_name_cmp(const void *a, const void *b)
+{
+	return strcmp((*(struct map_sym**) a)->s->name, (*(struct map_sym**) b)->s->name);
+}
+
+// -----------------------------------------------------------------------
+static int map_write(struct raw_out *o, struct map *m, struct map_sym **by_name)
+{
+	uint32_t strings = MAP_HEADER_WORDS + m->count * (MAP_SYM_WORDS + 2) + m->files.count * 2;
+	uint32_t pos = 0;
+
+	uint16_t head[4] = { MAP_MAGIC_HI, MAP_MAGIC_LO, MAP_VERSION, 0 };
+	if (raw_put(o, head, 4) || raw_put32(o, m->count) || raw_put32(o, m->files.count) || raw_put32(o, strings)) {
+		return -1;
+	}
+
+	for (int i=0 ; i<m->count ; i++) {
+		struct map_sym *ms = m->syms + i;
+		uint16_t w[2] = { ms->flags, ms->file };
+		if (raw_put32(o, ms->value) || raw_put(o, w, 2) || raw_put32(o, ms->line) || raw_put32(o, pos)) {
+			return -1;
+		}
+		pos += strlen(ms->s->name) + 1;
+	}
+
+	for (int i=0 ; i<m->count ; i++) {
+		if (raw_put32(o, by_name[i] - m->syms)) {
+			return -1;
+		}
+	}
+
+	for (int i=0 ; i<m->files.count ; i++) {
+		if (raw_put32(o, pos)) {
+			return -1;
+		}
+		pos += strlen(m->files.names[i]) + 1;
+	}
+
+	struct raw_bytes b = { o, 0, 0 };
+	for (int i=0 ; i<m->count ; i++) {
+		if (raw_str(&b, m->syms[i].s->name)) {
+			return -1;
+		}
+	}
+	for (int i=0 ; i<m->files.count ; i++) {
+		if (raw_str(&b, m->files.names[i])) {
+			return -1;
+		}
+	}
+
+	return raw_bytes_end(&b);
+}
+
+// -----------------------------------------------------------------------
+int writer_map(struct emas_ctx *ctx, FILE *f)
+{
+	struct map m = { ctx, NULL, 0, 0, { NULL, 0 } };
+	struct map_sym **by_name = NULL;
+	struct raw_out *o = NULL;
+	int res = 1;
+
+	AADEBUG(ctx, "==== MAP writer ================================");
+
+	if (map_collect(&m, ctx->sym)) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the symbol map");
+		goto cleanup;
+	}
+
+	if (m.count) {
+		qsort(m.syms, m.count, sizeof(struct map_sym), map_sym_value_cmp);
+		by_name = malloc(m.count * sizeof(struct map_sym*));
+		if (!by_name) {
+			aaerror(ctx, NULL, "Cannot allocate memory for the symbol map");
+			goto cleanup;
+		}
+		for (int i=0 ; i<m.count ; i++) {
+			by_name[i] = m.syms + i;
+		}
+		qsort(by_name, m.count, sizeof(struct map_sym*), map_sym_name_cmp);
+	}
+
+	o = malloc(sizeof(struct raw_out));
+	if (!o) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the output buffer");
+		goto cleanup;
+	}
+	o->f = f;
+	o->seekable = 0;
+	o->ic = 0;
+	o->len = 0;
+
+	if (map_write(o, &m, by_name) || raw_flush(o)) {
+		aaerror(ctx, NULL, "Write failed");
+		goto cleanup;
+	}
+
+	res = 0;
+
+cleanup:
+	free(o);
+	free(by_name);
+	free(m.syms);
+	free(m.files.names);
+
+	return res;
+}
+
+// Line table row
+struct lines_row {
+	uint32_t addr;
+	uint32_t line;
+	uint16_t file;
+};
+
+// Line table being built
+struct lines {
+	struct lines_row *rows;
+	int count;
+	int cap;
+	struct file_list files;
+	uint8_t *data;		// encoded rows
+	int len;
+	int data_cap;
+};
+
+// -----------------------------------------------------------------------
+// Add a row, unless the previous one already covers the address
+static int lines_add(struct lines *l, uint32_t addr, uint16_t file, uint32_t line)
+{
+	if (l->count) {
+		struct lines_row *last = l->rows + l->count - 1;
+		if ((last->file == file) && (last->line == line)) {
+			return 0;
+		}
+		// previous row covers no words
+		if (last->addr == addr) {
+			l->count--;
+		}
+	}
+
+	if (l->count >= l->cap) {
+		int cap = l->cap ? l->cap * 2 : 1024;
+		struct lines_row *rows = realloc(l->rows, cap * sizeof(struct lines_row));
+		if (!rows) {
+			return -1;
+		}
+		l->rows = rows;
+		l->cap = cap;
+	}
+
+	struct lines_row *r = l->rows + l->count++;
+	r->addr = addr;
+	r->line = line;
+	r->file = file;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int lines_collect(struct emas_ctx *ctx, struct lines *l)
+{
+	int end = -1;
+
+	for (int n=0 ; n<ctx->stmt_count ; n++) {
+		struct st *t = ctx->stmts[n];
+		if (t->size <= 0) continue;
+		if ((end >= 0) && (t->ic > end) && lines_add(l, end, LINES_NO_FILE, 0)) {
+			return -1;
+		}
+		struct st_loc *loc = st_loc(ctx, t);
+		int file = loc->stmt_file ? file_index(&l->files, loc->stmt_file) : LINES_NO_FILE;
+		if ((file < 0) || lines_add(l, t->ic, file, loc->stmt_file ? loc->stmt_line : 0)) {
+			return -1;
+		}
+		end = t->ic + t->size;
+	}
+
+	if ((end >= 0) && lines_add(l, end, LINES_NO_FILE, 0)) {
+		return -1;
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+static int lines_varint(struct lines *l, uint64_t value)
+{
+	// 10 bytes is enough for any 64-bit value
+	if (l->len + 10 > l->data_cap) {
+		int cap = l->data_cap ? l->data_cap * 2 : 4096;
+		uint8_t *data = realloc(l->data, cap);
+		if (!data) {
+			return -1;
+		}
+		l->data = data;
+		l->data_cap = cap;
+	}
+
+	while (value >= 0x80) {
+		l->data[l->len++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	l->data[l->len++] = value;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Encode a row as a difference to the previous one
+static int lines_encode(struct lines *l, struct lines_row *r, struct lines_row *prev)
+{
+	int64_t dline = (int64_t) r->line - prev->line;
+	int file_changed = (r->file != prev->file);
+
+	if (lines_varint(l, ((uint64_t) (r->addr - prev->addr) << 1) | file_changed)) {
+		return -1;
+	}
+	if (file_changed && lines_varint(l, r->file)) {
+		return -1;
+	}
+
+	return lines_varint(l, dline < 0 ? ((uint64_t) -dline << 1) - 1 : (uint64_t) dline << 1);
+}
+
+// -----------------------------------------------------------------------
+static int lines_write(struct raw_out *o, struct lines *l, uint32_t *offsets, int blocks)
+{
+	uint32_t data = LINES_HEADER_WORDS + blocks * LINES_BLOCK_WORDS + l->files.count * 2;
+	uint32_t strings = data + (l->len + 1) / 2;
+	uint32_t pos = 0;
+
+	uint16_t head[4] = { LINES_MAGIC_HI, LINES_MAGIC_LO, LINES_VERSION, 0 };
+	if (raw_put(o, head, 4) || raw_put32(o, l->count) || raw_put32(o, blocks) || raw_put32(o, l->files.count) || raw_put32(o, data) || raw_put32(o, strings)) {
+		return -1;
+	}
+
+	for (int i=0 ; i<blocks ; i++) {
+		struct lines_row *r = l->rows + i * LINES_BLOCK_ROWS;
+		if (raw_put32(o, r->addr) || raw_put32(o, r->line) || raw_put(o, &r->file, 1) || raw_put32(o, offsets[i])) {
+			return -1;
+		}
+	}
+
+	for (int i=0 ; i<l->files.count ; i++) {
+		if (raw_put32(o, pos)) {
+			return -1;
+		}
+		pos += strlen(l->files.names[i]) + 1;
+	}
+
+	struct raw_bytes b = { o, 0, 0 };
+	for (int i=0 ; i<l->len ; i++) {
+		if (raw_byte(&b, l->data[i])) {
+			return -1;
+		}
+	}
+	if (raw_bytes_end(&b)) {
+		return -1;
+	}
+
+	for (int i=0 ; i<l->files.count ; i++) {
+		if (raw_str(&b, l->files.names[i])) {
+			return -1;
+		}
+	}
+
+	return raw_bytes_end(&b);
+}
+
+// -----------------------------------------------------------------------
+int writer_lines(struct emas_ctx *ctx, FILE *f)
+{
+	struct lines l;
+	uint32_t *offsets = NULL;
+	struct raw_out *o = NULL;
+	int res = 1;
+
+	AADEBUG(ctx, "==== LINES writer ================================");
+
+	memset(&l, 0, sizeof(struct lines));
+
+	if (lines_collect(ctx, &l)) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the line table");
+		goto cleanup;
+	}
+
+	int blocks = (l.count + LINES_BLOCK_ROWS - 1) / LINES_BLOCK_ROWS;
+	if (blocks) {
+		offsets = malloc(blocks * sizeof(uint32_t));
+		if (!offsets) {
+			aaerror(ctx, NULL, "Cannot allocate memory for the line table");
+			goto cleanup;
+		}
+	}
+	for (int i=0 ; i<l.count ; i++) {
+		if (i % LINES_BLOCK_ROWS == 0) {
+			offsets[i / LINES_BLOCK_ROWS] = l.len;
+		} else if (lines_encode(&l, l.rows+i, l.rows+i-1)) {
+			aaerror(ctx, NULL, "Cannot allocate memory for the line table");
+			goto cleanup;
+		}
+	}
+
+	o = malloc(sizeof(struct raw_out));
+	if (!o) {
+		aaerror(ctx, NULL, "Cannot allocate memory for the output buffer");
+		goto cleanup;
+	}
+	o->f = f;
+	o->seekable = 0;
+	o->ic = 0;
+	o->len = 0;
+
+	if (lines_write(o, &l, offsets, blocks) || raw_flush(o)) {
+		aaerror(ctx, NULL, "Write failed");
+		goto cleanup;
+	}
+
+	res = 0;
+
+cleanup:
+	free(o);
+	free(offsets);
+	free(l.rows);
+	free(l.data);
+	free(l.files.names);
+
+	return res;
+}
+
 // vim: tabstop=4 autoindent
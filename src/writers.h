@@ -18,11 +18,20 @@
 #ifndef WRITERS_H
 #define WRITERS_H
 
+#include <stdio.h>
+
 #include "st.h"
 
-int writer_debug(struct st *prog, FILE *f);
-int writer_raw(struct st *prog, FILE *f);
-int writer_keys(struct st *prog, FILE *f);
+struct emas_ctx;
+
+int writer_debug(struct emas_ctx *ctx, FILE *f);
+int writer_raw(struct emas_ctx *ctx, FILE *f);
+int writer_keys(struct emas_ctx *ctx, FILE *f);
+int writer_obj(struct emas_ctx *ctx, FILE *f);
+int writer_seg(struct emas_ctx *ctx, FILE *f);
+int writer_listing(struct emas_ctx *ctx, FILE *f);
+int writer_map(struct emas_ctx *ctx, FILE *f);
+int writer_lines(struct emas_ctx *ctx, FILE *f);
 
 #endif
 
@@ -0,0 +1,4204 @@
+; emas-test: -j 4
+; errors in two encoding chunks, the first one in program order is reported
+start:
+	.word	0
+	.word	1
+	.word	2
+	.word	3
+	.word	4
+	.word	5
+	.word	6
+	.word	7
+	.word	8
+	.word	9
+	.word	10
+	.word	11
+	.word	12
+	.word	13
+	.word	14
+	.word	15
+	.word	16
+	.word	17
+	.word	18
+	.word	19
+	.word	20
+	.word	21
+	.word	22
+	.word	23
+	.word	24
+	.word	25
+	.word	26
+	.word	27
+	.word	28
+	.word	29
+	.word	30
+	.word	31
+	.word	32
+	.word	33
+	.word	34
+	.word	35
+	.word	36
+	.word	37
+	.word	38
+	.word	39
+	.word	40
+	.word	41
+	.word	42
+	.word	43
+	.word	44
+	.word	45
+	.word	46
+	.word	47
+	.word	48
+	.word	49
+	hlt	50
+	.word	51
+	.word	52
+	.word	53
+	.word	54
+	.word	55
+	.word	56
+	.word	57
+	.word	58
+	.word	59
+	.word	60
+	.word	61
+	.word	62
+	.word	63
+	.word	64
+	.word	65
+	.word	66
+	.word	67
+	.word	68
+	.word	69
+	.word	70
+	.word	71
+	.word	72
+	.word	73
+	.word	74
+	.word	75
+	.word	76
+	.word	77
+	.word	78
+	.word	79
+	.word	80
+	.word	81
+	.word	82
+	.word	83
+	.word	84
+	.word	85
+	.word	86
+	.word	87
+	.word	88
+	.word	89
+	.word	90
+	.word	91
+	.word	92
+	.word	93
+	.word	94
+	.word	95
+	.word	96
+	.word	97
+	.word	98
+	.word	end-start, 99
+	.word	100
+	.word	101
+	.word	102
+	.word	103
+	.word	104
+	.word	105
+	.word	106
+	.word	107
+	.word	108
+	.word	109
+	.word	110
+	.word	111
+	.word	112
+	.word	113
+	.word	114
+	.word	115
+	.word	116
+	.word	117
+	.word	118
+	.word	119
+	.word	120
+	.word	121
+	.word	122
+	.word	123
+	.word	124
+	.word	125
+	.word	126
+	.word	127
+	.word	128
+	.word	129
+	.word	130
+	.word	131
+	.word	132
+	.word	133
+	.word	134
+	.word	135
+	.word	136
+	.word	137
+	.word	138
+	.word	139
+	.word	140
+	.word	141
+	.word	142
+	.word	143
+	.word	144
+	.word	145
+	.word	146
+	.word	147
+	.word	148
+	.word	149
+	hlt	22
+	.word	151
+	.word	152
+	.word	153
+	.word	154
+	.word	155
+	.word	156
+	.word	157
+	.word	158
+	.word	159
+	.word	160
+	.word	161
+	.word	162
+	.word	163
+	.word	164
+	.word	165
+	.word	166
+	.word	167
+	.word	168
+	.word	169
+	.word	170
+	.word	171
+	.word	172
+	.word	173
+	.word	174
+	.word	175
+	.word	176
+	.word	177
+	.word	178
+	.word	179
+	.word	180
+	.word	181
+	.word	182
+	.word	183
+	.word	184
+	.word	185
+	.word	186
+	.word	187
+	.word	188
+	.word	189
+	.word	190
+	.word	191
+	.word	192
+	.word	193
+	.word	194
+	.word	195
+	.word	196
+	.word	197
+	.word	198
+	.word	end-start, 199
+	.word	200
+	.word	201
+	.word	202
+	.word	203
+	.word	204
+	.word	205
+	.word	206
+	.word	207
+	.word	208
+	.word	209
+	.word	210
+	.word	211
+	.word	212
+	.word	213
+	.word	214
+	.word	215
+	.word	216
+	.word	217
+	.word	218
+	.word	219
+	.word	220
+	.word	221
+	.word	222
+	.word	223
+	.word	224
+	.word	225
+	.word	226
+	.word	227
+	.word	228
+	.word	229
+	.word	230
+	.word	231
+	.word	232
+	.word	233
+	.word	234
+	.word	235
+	.word	236
+	.word	237
+	.word	238
+	.word	239
+	.word	240
+	.word	241
+	.word	242
+	.word	243
+	.word	244
+	.word	245
+	.word	246
+	.word	247
+	.word	248
+	.word	249
+	hlt	58
+	.word	251
+	.word	252
+	.word	253
+	.word	254
+	.word	255
+	.word	256
+	.word	257
+	.word	258
+	.word	259
+	.word	260
+	.word	261
+	.word	262
+	.word	263
+	.word	264
+	.word	265
+	.word	266
+	.word	267
+	.word	268
+	.word	269
+	.word	270
+	.word	271
+	.word	272
+	.word	273
+	.word	274
+	.word	275
+	.word	276
+	.word	277
+	.word	278
+	.word	279
+	.word	280
+	.word	281
+	.word	282
+	.word	283
+	.word	284
+	.word	285
+	.word	286
+	.word	287
+	.word	288
+	.word	289
+	.word	290
+	.word	291
+	.word	292
+	.word	293
+	.word	294
+	.word	295
+	.word	296
+	.word	297
+	.word	298
+	.word	end-start, 299
+	.word	300
+	.word	301
+	.word	302
+	.word	303
+	.word	304
+	.word	305
+	.word	306
+	.word	307
+	.word	308
+	.word	309
+	.word	310
+	.word	311
+	.word	312
+	.word	313
+	.word	314
+	.word	315
+	.word	316
+	.word	317
+	.word	318
+	.word	319
+	.word	320
+	.word	321
+	.word	322
+	.word	323
+	.word	324
+	.word	325
+	.word	326
+	.word	327
+	.word	328
+	.word	329
+	.word	330
+	.word	331
+	.word	332
+	.word	333
+	.word	334
+	.word	335
+	.word	336
+	.word	337
+	.word	338
+	.word	339
+	.word	340
+	.word	341
+	.word	342
+	.word	343
+	.word	344
+	.word	345
+	.word	346
+	.word	347
+	.word	348
+	.word	349
+	hlt	30
+	.word	351
+	.word	352
+	.word	353
+	.word	354
+	.word	355
+	.word	356
+	.word	357
+	.word	358
+	.word	359
+	.word	360
+	.word	361
+	.word	362
+	.word	363
+	.word	364
+	.word	365
+	.word	366
+	.word	367
+	.word	368
+	.word	369
+	.word	370
+	.word	371
+	.word	372
+	.word	373
+	.word	374
+	.word	375
+	.word	376
+	.word	377
+	.word	378
+	.word	379
+	.word	380
+	.word	381
+	.word	382
+	.word	383
+	.word	384
+	.word	385
+	.word	386
+	.word	387
+	.word	388
+	.word	389
+	.word	390
+	.word	391
+	.word	392
+	.word	393
+	.word	394
+	.word	395
+	.word	396
+	.word	397
+	.word	398
+	.word	end-start, 399
+	.word	400
+	.word	401
+	.word	402
+	.word	403
+	.word	404
+	.word	405
+	.word	406
+	.word	407
+	.word	408
+	.word	409
+	.word	410
+	.word	411
+	.word	412
+	.word	413
+	.word	414
+	.word	415
+	.word	416
+	.word	417
+	.word	418
+	.word	419
+	.word	420
+	.word	421
+	.word	422
+	.word	423
+	.word	424
+	.word	425
+	.word	426
+	.word	427
+	.word	428
+	.word	429
+	.word	430
+	.word	431
+	.word	432
+	.word	433
+	.word	434
+	.word	435
+	.word	436
+	.word	437
+	.word	438
+	.word	439
+	.word	440
+	.word	441
+	.word	442
+	.word	443
+	.word	444
+	.word	445
+	.word	446
+	.word	447
+	.word	448
+	.word	449
+	hlt	2
+	.word	451
+	.word	452
+	.word	453
+	.word	454
+	.word	455
+	.word	456
+	.word	457
+	.word	458
+	.word	459
+	.word	460
+	.word	461
+	.word	462
+	.word	463
+	.word	464
+	.word	465
+	.word	466
+	.word	467
+	.word	468
+	.word	469
+	.word	470
+	.word	471
+	.word	472
+	.word	473
+	.word	474
+	.word	475
+	.word	476
+	.word	477
+	.word	478
+	.word	479
+	.word	480
+	.word	481
+	.word	482
+	.word	483
+	.word	484
+	.word	485
+	.word	486
+	.word	487
+	.word	488
+	.word	489
+	.word	490
+	.word	491
+	.word	492
+	.word	493
+	.word	494
+	.word	495
+	.word	496
+	.word	497
+	.word	498
+	.word	end-start, 499
+	.word	500
+	.word	501
+	.word	502
+	.word	503
+	.word	504
+	.word	505
+	.word	506
+	.word	507
+	.word	508
+	.word	509
+	.word	510
+	.word	511
+	.word	512
+	.word	513
+	.word	514
+	.word	515
+	.word	516
+	.word	517
+	.word	518
+	.word	519
+	.word	520
+	.word	521
+	.word	522
+	.word	523
+	.word	524
+	.word	525
+	.word	526
+	.word	527
+	.word	528
+	.word	529
+	.word	530
+	.word	531
+	.word	532
+	.word	533
+	.word	534
+	.word	535
+	.word	536
+	.word	537
+	.word	538
+	.word	539
+	.word	540
+	.word	541
+	.word	542
+	.word	543
+	.word	544
+	.word	545
+	.word	546
+	.word	547
+	.word	548
+	.word	549
+	hlt	38
+	.word	551
+	.word	552
+	.word	553
+	.word	554
+	.word	555
+	.word	556
+	.word	557
+	.word	558
+	.word	559
+	.word	560
+	.word	561
+	.word	562
+	.word	563
+	.word	564
+	.word	565
+	.word	566
+	.word	567
+	.word	568
+	.word	569
+	.word	570
+	.word	571
+	.word	572
+	.word	573
+	.word	574
+	.word	575
+	.word	576
+	.word	577
+	.word	578
+	.word	579
+	.word	580
+	.word	581
+	.word	582
+	.word	583
+	.word	584
+	.word	585
+	.word	586
+	.word	587
+	.word	588
+	.word	589
+	.word	590
+	.word	591
+	.word	592
+	.word	593
+	.word	594
+	.word	595
+	.word	596
+	.word	597
+	.word	598
+	.word	end-start, 599
+	.word	600
+	.word	601
+	.word	602
+	.word	603
+	.word	604
+	.word	605
+	.word	606
+	.word	607
+	.word	608
+	.word	609
+	.word	610
+	.word	611
+	.word	612
+	.word	613
+	.word	614
+	.word	615
+	.word	616
+	.word	617
+	.word	618
+	.word	619
+	.word	620
+	.word	621
+	.word	622
+	.word	623
+	.word	624
+	.word	625
+	.word	626
+	.word	627
+	.word	628
+	.word	629
+	.word	630
+	.word	631
+	.word	632
+	.word	633
+	.word	634
+	.word	635
+	.word	636
+	.word	637
+	.word	638
+	.word	639
+	.word	640
+	.word	641
+	.word	642
+	.word	643
+	.word	644
+	.word	645
+	.word	646
+	.word	647
+	.word	648
+	.word	649
+	hlt	10
+	.word	651
+	.word	652
+	.word	653
+	.word	654
+	.word	655
+	.word	656
+	.word	657
+	.word	658
+	.word	659
+	.word	660
+	.word	661
+	.word	662
+	.word	663
+	.word	664
+	.word	665
+	.word	666
+	.word	667
+	.word	668
+	.word	669
+	.word	670
+	.word	671
+	.word	672
+	.word	673
+	.word	674
+	.word	675
+	.word	676
+	.word	677
+	.word	678
+	.word	679
+	.word	680
+	.word	681
+	.word	682
+	.word	683
+	.word	684
+	.word	685
+	.word	686
+	.word	687
+	.word	688
+	.word	689
+	.word	690
+	.word	691
+	.word	692
+	.word	693
+	.word	694
+	.word	695
+	.word	696
+	.word	697
+	.word	698
+	.word	end-start, 699
+	.word	700
+	.word	701
+	.word	702
+	.word	703
+	.word	704
+	.word	705
+	.word	706
+	.word	707
+	.word	708
+	.word	709
+	.word	710
+	.word	711
+	.word	712
+	.word	713
+	.word	714
+	.word	715
+	.word	716
+	.word	717
+	.word	718
+	.word	719
+	.word	720
+	.word	721
+	.word	722
+	.word	723
+	.word	724
+	.word	725
+	.word	726
+	.word	727
+	.word	728
+	.word	729
+	.word	730
+	.word	731
+	.word	732
+	.word	733
+	.word	734
+	.word	735
+	.word	736
+	.word	737
+	.word	738
+	.word	739
+	.word	740
+	.word	741
+	.word	742
+	.word	743
+	.word	744
+	.word	745
+	.word	746
+	.word	747
+	.word	748
+	.word	749
+	hlt	46
+	.word	751
+	.word	752
+	.word	753
+	.word	754
+	.word	755
+	.word	756
+	.word	757
+	.word	758
+	.word	759
+	.word	760
+	.word	761
+	.word	762
+	.word	763
+	.word	764
+	.word	765
+	.word	766
+	.word	767
+	.word	768
+	.word	769
+	.word	770
+	.word	771
+	.word	772
+	.word	773
+	.word	774
+	.word	775
+	.word	776
+	.word	777
+	.word	778
+	.word	779
+	.word	780
+	.word	781
+	.word	782
+	.word	783
+	.word	784
+	.word	785
+	.word	786
+	.word	787
+	.word	788
+	.word	789
+	.word	790
+	.word	791
+	.word	792
+	.word	793
+	.word	794
+	.word	795
+	.word	796
+	.word	797
+	.word	798
+	.word	end-start, 799
+	.word	800
+	.word	801
+	.word	802
+	.word	803
+	.word	804
+	.word	805
+	.word	806
+	.word	807
+	.word	808
+	.word	809
+	.word	810
+	.word	811
+	.word	812
+	.word	813
+	.word	814
+	.word	815
+	.word	816
+	.word	817
+	.word	818
+	.word	819
+	.word	820
+	.word	821
+	.word	822
+	.word	823
+	.word	824
+	.word	825
+	.word	826
+	.word	827
+	.word	828
+	.word	829
+	.word	830
+	.word	831
+	.word	832
+	.word	833
+	.word	834
+	.word	835
+	.word	836
+	.word	837
+	.word	838
+	.word	839
+	.word	840
+	.word	841
+	.word	842
+	.word	843
+	.word	844
+	.word	845
+	.word	846
+	.word	847
+	.word	848
+	.word	849
+	hlt	18
+	.word	851
+	.word	852
+	.word	853
+	.word	854
+	.word	855
+	.word	856
+	.word	857
+	.word	858
+	.word	859
+	.word	860
+	.word	861
+	.word	862
+	.word	863
+	.word	864
+	.word	865
+	.word	866
+	.word	867
+	.word	868
+	.word	869
+	.word	870
+	.word	871
+	.word	872
+	.word	873
+	.word	874
+	.word	875
+	.word	876
+	.word	877
+	.word	878
+	.word	879
+	.word	880
+	.word	881
+	.word	882
+	.word	883
+	.word	884
+	.word	885
+	.word	886
+	.word	887
+	.word	888
+	.word	889
+	.word	890
+	.word	891
+	.word	892
+	.word	893
+	.word	894
+	.word	895
+	.word	896
+	.word	897
+	.word	898
+	.word	end-start, 899
+	.word	900
+	.word	901
+	.word	902
+	.word	903
+	.word	904
+	.word	905
+	.word	906
+	.word	907
+	.word	908
+	.word	909
+	.word	910
+	.word	911
+	.word	912
+	.word	913
+	.word	914
+	.word	915
+	.word	916
+	.word	917
+	.word	918
+	.word	919
+	.word	920
+	.word	921
+	.word	922
+	.word	923
+	.word	924
+	.word	925
+	.word	926
+	.word	927
+	.word	928
+	.word	929
+	.word	930
+	.word	931
+	.word	932
+	.word	933
+	.word	934
+	.word	935
+	.word	936
+	.word	937
+	.word	938
+	.word	939
+	.word	940
+	.word	941
+	.word	942
+	.word	943
+	.word	944
+	.word	945
+	.word	946
+	.word	947
+	.word	948
+	.word	949
+	hlt	54
+	.word	951
+	.word	952
+	.word	953
+	.word	954
+	.word	955
+	.word	956
+	.word	957
+	.word	958
+	.word	959
+	.word	960
+	.word	961
+	.word	962
+	.word	963
+	.word	964
+	.word	965
+	.word	966
+	.word	967
+	.word	968
+	.word	969
+	.word	970
+	.word	971
+	.word	972
+	.word	973
+	.word	974
+	.word	975
+	.word	976
+	.word	977
+	.word	978
+	.word	979
+	.word	980
+	.word	981
+	.word	982
+	.word	983
+	.word	984
+	.word	985
+	.word	986
+	.word	987
+	.word	988
+	.word	989
+	.word	990
+	.word	991
+	.word	992
+	.word	993
+	.word	994
+	.word	995
+	.word	996
+	.word	997
+	.word	998
+	.word	end-start, 999
+	.word	1000
+	.word	1001
+	.word	1002
+	.word	1003
+	.word	1004
+	.word	1005
+	.word	1006
+	.word	1007
+	.word	1008
+	.word	1009
+	.word	1010
+	.word	1011
+	.word	1012
+	.word	1013
+	.word	1014
+	.word	1015
+	.word	1016
+	.word	1017
+	.word	1018
+	.word	1019
+	.word	1020
+	.word	1021
+	.word	1022
+	.word	1023
+	.word	1024
+	.word	1025
+	.word	1026
+	.word	1027
+	.word	1028
+	.word	1029
+	.word	1030
+	.word	1031
+	.word	1032
+	.word	1033
+	.word	1034
+	.word	1035
+	.word	1036
+	.word	1037
+	.word	1038
+	.word	1039
+	.word	1040
+	.word	1041
+	.word	1042
+	.word	1043
+	.word	1044
+	.word	1045
+	.word	1046
+	.word	1047
+	.word	1048
+	.word	1049
+	hlt	26
+	.word	1051
+	.word	1052
+	.word	1053
+	.word	1054
+	.word	1055
+	.word	1056
+	.word	1057
+	.word	1058
+	.word	1059
+	.word	1060
+	.word	1061
+	.word	1062
+	.word	1063
+	.word	1064
+	.word	1065
+	.word	1066
+	.word	1067
+	.word	1068
+	.word	1069
+	.word	1070
+	.word	1071
+	.word	1072
+	.word	1073
+	.word	1074
+	.word	1075
+	.word	1076
+	.word	1077
+	.word	1078
+	.word	1079
+	.word	1080
+	.word	1081
+	.word	1082
+	.word	1083
+	.word	1084
+	.word	1085
+	.word	1086
+	.word	1087
+	.word	1088
+	.word	1089
+	.word	1090
+	.word	1091
+	.word	1092
+	.word	1093
+	.word	1094
+	.word	1095
+	.word	1096
+	.word	1097
+	.word	1098
+	.word	end-start, 1099
+	.word	1100
+	.word	1101
+	.word	1102
+	.word	1103
+	.word	1104
+	.word	1105
+	.word	1106
+	.word	1107
+	.word	1108
+	.word	1109
+	.word	1110
+	.word	1111
+	.word	1112
+	.word	1113
+	.word	1114
+	.word	1115
+	.word	1116
+	.word	1117
+	.word	1118
+	.word	1119
+	.word	1120
+	.word	1121
+	.word	1122
+	.word	1123
+	.word	1124
+	.word	1125
+	.word	1126
+	.word	1127
+	.word	1128
+	.word	1129
+	.word	1130
+	.word	1131
+	.word	1132
+	.word	1133
+	.word	1134
+	.word	1135
+	.word	1136
+	.word	1137
+	.word	1138
+	.word	1139
+	.word	1140
+	.word	1141
+	.word	1142
+	.word	1143
+	.word	1144
+	.word	1145
+	.word	1146
+	.word	1147
+	.word	1148
+	.word	1149
+	hlt	62
+	.word	1151
+	.word	1152
+	.word	1153
+	.word	1154
+	.word	1155
+	.word	1156
+	.word	1157
+	.word	1158
+	.word	1159
+	.word	1160
+	.word	1161
+	.word	1162
+	.word	1163
+	.word	1164
+	.word	1165
+	.word	1166
+	.word	1167
+	.word	1168
+	.word	1169
+	.word	1170
+	.word	1171
+	.word	1172
+	.word	1173
+	.word	1174
+	.word	1175
+	.word	1176
+	.word	1177
+	.word	1178
+	.word	1179
+	.word	1180
+	.word	1181
+	.word	1182
+	.word	1183
+	.word	1184
+	.word	1185
+	.word	1186
+	.word	1187
+	.word	1188
+	.word	1189
+	.word	1190
+	.word	1191
+	.word	1192
+	.word	1193
+	.word	1194
+	.word	1195
+	.word	1196
+	.word	1197
+	.word	1198
+	.word	end-start, 1199
+	.word	1200
+	.word	1201
+	.word	1202
+	.word	1203
+	.word	1204
+	.word	1205
+	.word	1206
+	.word	1207
+	.word	1208
+	.word	1209
+	.word	1210
+	.word	1211
+	.word	1212
+	.word	1213
+	.word	1214
+	.word	1215
+	.word	1216
+	.word	1217
+	.word	1218
+	.word	1219
+	.word	1220
+	.word	1221
+	.word	1222
+	.word	1223
+	.word	1224
+	.word	1225
+	.word	1226
+	.word	1227
+	.word	1228
+	.word	1229
+	.word	1230
+	.word	1231
+	.word	1232
+	.word	1233
+	.word	1234
+	.word	1235
+	.word	1236
+	.word	1237
+	.word	1238
+	.word	1239
+	.word	1240
+	.word	1241
+	.word	1242
+	.word	1243
+	.word	1244
+	.word	1245
+	.word	1246
+	.word	1247
+	.word	1248
+	.word	1249
+	hlt	34
+	.word	1251
+	.word	1252
+	.word	1253
+	.word	1254
+	.word	1255
+	.word	1256
+	.word	1257
+	.word	1258
+	.word	1259
+	.word	1260
+	.word	1261
+	.word	1262
+	.word	1263
+	.word	1264
+	.word	1265
+	.word	1266
+	.word	1267
+	.word	1268
+	.word	1269
+	.word	1270
+	.word	1271
+	.word	1272
+	.word	1273
+	.word	1274
+	.word	1275
+	.word	1276
+	.word	1277
+	.word	1278
+	.word	1279
+	.word	1280
+	.word	1281
+	.word	1282
+	.word	1283
+	.word	1284
+	.word	1285
+	.word	1286
+	.word	1287
+	.word	1288
+	.word	1289
+	.word	1290
+	.word	1291
+	.word	1292
+	.word	1293
+	.word	1294
+	.word	1295
+	.word	1296
+	.word	1297
+	.word	1298
+	.word	end-start, 1299
+	.word	1300
+	.word	1301
+	.word	1302
+	.word	1303
+	.word	1304
+	.word	1305
+	.word	1306
+	.word	1307
+	.word	1308
+	.word	1309
+	.word	1310
+	.word	1311
+	.word	1312
+	.word	1313
+	.word	1314
+	.word	1315
+	.word	1316
+	.word	1317
+	.word	1318
+	.word	1319
+	.word	1320
+	.word	1321
+	.word	1322
+	.word	1323
+	.word	1324
+	.word	1325
+	.word	1326
+	.word	1327
+	.word	1328
+	.word	1329
+	.word	1330
+	.word	1331
+	.word	1332
+	.word	1333
+	.word	1334
+	.word	1335
+	.word	1336
+	.word	1337
+	.word	1338
+	.word	1339
+	.word	1340
+	.word	1341
+	.word	1342
+	.word	1343
+	.word	1344
+	.word	1345
+	.word	1346
+	.word	1347
+	.word	1348
+	.word	1349
+	hlt	6
+	.word	1351
+	.word	1352
+	.word	1353
+	.word	1354
+	.word	1355
+	.word	1356
+	.word	1357
+	.word	1358
+	.word	1359
+	.word	1360
+	.word	1361
+	.word	1362
+	.word	1363
+	.word	1364
+	.word	1365
+	.word	1366
+	.word	1367
+	.word	1368
+	.word	1369
+	.word	1370
+	.word	1371
+	.word	1372
+	.word	1373
+	.word	1374
+	.word	1375
+	.word	1376
+	.word	1377
+	.word	1378
+	.word	1379
+	.word	1380
+	.word	1381
+	.word	1382
+	.word	1383
+	.word	1384
+	.word	1385
+	.word	1386
+	.word	1387
+	.word	1388
+	.word	1389
+	.word	1390
+	.word	1391
+	.word	1392
+	.word	1393
+	.word	1394
+	.word	1395
+	.word	1396
+	.word	1397
+	.word	1398
+	.word	end-start, 1399
+	.word	1400
+	.word	1401
+	.word	1402
+	.word	1403
+	.word	1404
+	.word	1405
+	.word	1406
+	.word	1407
+	.word	1408
+	.word	1409
+	.word	1410
+	.word	1411
+	.word	1412
+	.word	1413
+	.word	1414
+	.word	1415
+	.word	1416
+	.word	1417
+	.word	1418
+	.word	1419
+	.word	1420
+	.word	1421
+	.word	1422
+	.word	1423
+	.word	1424
+	.word	1425
+	.word	1426
+	.word	1427
+	.word	1428
+	.word	1429
+	.word	1430
+	.word	1431
+	.word	1432
+	.word	1433
+	.word	1434
+	.word	1435
+	.word	1436
+	.word	1437
+	.word	1438
+	.word	1439
+	.word	1440
+	.word	1441
+	.word	1442
+	.word	1443
+	.word	1444
+	.word	1445
+	.word	1446
+	.word	1447
+	.word	1448
+	.word	1449
+	hlt	42
+	.word	1451
+	.word	1452
+	.word	1453
+	.word	1454
+	.word	1455
+	.word	1456
+	.word	1457
+	.word	1458
+	.word	1459
+	.word	1460
+	.word	1461
+	.word	1462
+	.word	1463
+	.word	1464
+	.word	1465
+	.word	1466
+	.word	1467
+	.word	1468
+	.word	1469
+	.word	1470
+	.word	1471
+	.word	1472
+	.word	1473
+	.word	1474
+	.word	1475
+	.word	1476
+	.word	1477
+	.word	1478
+	.word	1479
+	.word	1480
+	.word	1481
+	.word	1482
+	.word	1483
+	.word	1484
+	.word	1485
+	.word	1486
+	.word	1487
+	.word	1488
+	.word	1489
+	.word	1490
+	.word	1491
+	.word	1492
+	.word	1493
+	.word	1494
+	.word	1495
+	.word	1496
+	.word	1497
+	.word	1498
+	.word	end-start, 1499
+	exl	1000
+	.word	1501
+	.word	1502
+	.word	1503
+	.word	1504
+	.word	1505
+	.word	1506
+	.word	1507
+	.word	1508
+	.word	1509
+	.word	1510
+	.word	1511
+	.word	1512
+	.word	1513
+	.word	1514
+	.word	1515
+	.word	1516
+	.word	1517
+	.word	1518
+	.word	1519
+	.word	1520
+	.word	1521
+	.word	1522
+	.word	1523
+	.word	1524
+	.word	1525
+	.word	1526
+	.word	1527
+	.word	1528
+	.word	1529
+	.word	1530
+	.word	1531
+	.word	1532
+	.word	1533
+	.word	1534
+	.word	1535
+	.word	1536
+	.word	1537
+	.word	1538
+	.word	1539
+	.word	1540
+	.word	1541
+	.word	1542
+	.word	1543
+	.word	1544
+	.word	1545
+	.word	1546
+	.word	1547
+	.word	1548
+	.word	1549
+	hlt	14
+	.word	1551
+	.word	1552
+	.word	1553
+	.word	1554
+	.word	1555
+	.word	1556
+	.word	1557
+	.word	1558
+	.word	1559
+	.word	1560
+	.word	1561
+	.word	1562
+	.word	1563
+	.word	1564
+	.word	1565
+	.word	1566
+	.word	1567
+	.word	1568
+	.word	1569
+	.word	1570
+	.word	1571
+	.word	1572
+	.word	1573
+	.word	1574
+	.word	1575
+	.word	1576
+	.word	1577
+	.word	1578
+	.word	1579
+	.word	1580
+	.word	1581
+	.word	1582
+	.word	1583
+	.word	1584
+	.word	1585
+	.word	1586
+	.word	1587
+	.word	1588
+	.word	1589
+	.word	1590
+	.word	1591
+	.word	1592
+	.word	1593
+	.word	1594
+	.word	1595
+	.word	1596
+	.word	1597
+	.word	1598
+	.word	end-start, 1599
+	.word	1600
+	.word	1601
+	.word	1602
+	.word	1603
+	.word	1604
+	.word	1605
+	.word	1606
+	.word	1607
+	.word	1608
+	.word	1609
+	.word	1610
+	.word	1611
+	.word	1612
+	.word	1613
+	.word	1614
+	.word	1615
+	.word	1616
+	.word	1617
+	.word	1618
+	.word	1619
+	.word	1620
+	.word	1621
+	.word	1622
+	.word	1623
+	.word	1624
+	.word	1625
+	.word	1626
+	.word	1627
+	.word	1628
+	.word	1629
+	.word	1630
+	.word	1631
+	.word	1632
+	.word	1633
+	.word	1634
+	.word	1635
+	.word	1636
+	.word	1637
+	.word	1638
+	.word	1639
+	.word	1640
+	.word	1641
+	.word	1642
+	.word	1643
+	.word	1644
+	.word	1645
+	.word	1646
+	.word	1647
+	.word	1648
+	.word	1649
+	hlt	50
+	.word	1651
+	.word	1652
+	.word	1653
+	.word	1654
+	.word	1655
+	.word	1656
+	.word	1657
+	.word	1658
+	.word	1659
+	.word	1660
+	.word	1661
+	.word	1662
+	.word	1663
+	.word	1664
+	.word	1665
+	.word	1666
+	.word	1667
+	.word	1668
+	.word	1669
+	.word	1670
+	.word	1671
+	.word	1672
+	.word	1673
+	.word	1674
+	.word	1675
+	.word	1676
+	.word	1677
+	.word	1678
+	.word	1679
+	.word	1680
+	.word	1681
+	.word	1682
+	.word	1683
+	.word	1684
+	.word	1685
+	.word	1686
+	.word	1687
+	.word	1688
+	.word	1689
+	.word	1690
+	.word	1691
+	.word	1692
+	.word	1693
+	.word	1694
+	.word	1695
+	.word	1696
+	.word	1697
+	.word	1698
+	.word	end-start, 1699
+	.word	1700
+	.word	1701
+	.word	1702
+	.word	1703
+	.word	1704
+	.word	1705
+	.word	1706
+	.word	1707
+	.word	1708
+	.word	1709
+	.word	1710
+	.word	1711
+	.word	1712
+	.word	1713
+	.word	1714
+	.word	1715
+	.word	1716
+	.word	1717
+	.word	1718
+	.word	1719
+	.word	1720
+	.word	1721
+	.word	1722
+	.word	1723
+	.word	1724
+	.word	1725
+	.word	1726
+	.word	1727
+	.word	1728
+	.word	1729
+	.word	1730
+	.word	1731
+	.word	1732
+	.word	1733
+	.word	1734
+	.word	1735
+	.word	1736
+	.word	1737
+	.word	1738
+	.word	1739
+	.word	1740
+	.word	1741
+	.word	1742
+	.word	1743
+	.word	1744
+	.word	1745
+	.word	1746
+	.word	1747
+	.word	1748
+	.word	1749
+	hlt	22
+	.word	1751
+	.word	1752
+	.word	1753
+	.word	1754
+	.word	1755
+	.word	1756
+	.word	1757
+	.word	1758
+	.word	1759
+	.word	1760
+	.word	1761
+	.word	1762
+	.word	1763
+	.word	1764
+	.word	1765
+	.word	1766
+	.word	1767
+	.word	1768
+	.word	1769
+	.word	1770
+	.word	1771
+	.word	1772
+	.word	1773
+	.word	1774
+	.word	1775
+	.word	1776
+	.word	1777
+	.word	1778
+	.word	1779
+	.word	1780
+	.word	1781
+	.word	1782
+	.word	1783
+	.word	1784
+	.word	1785
+	.word	1786
+	.word	1787
+	.word	1788
+	.word	1789
+	.word	1790
+	.word	1791
+	.word	1792
+	.word	1793
+	.word	1794
+	.word	1795
+	.word	1796
+	.word	1797
+	.word	1798
+	.word	end-start, 1799
+	.word	1800
+	.word	1801
+	.word	1802
+	.word	1803
+	.word	1804
+	.word	1805
+	.word	1806
+	.word	1807
+	.word	1808
+	.word	1809
+	.word	1810
+	.word	1811
+	.word	1812
+	.word	1813
+	.word	1814
+	.word	1815
+	.word	1816
+	.word	1817
+	.word	1818
+	.word	1819
+	.word	1820
+	.word	1821
+	.word	1822
+	.word	1823
+	.word	1824
+	.word	1825
+	.word	1826
+	.word	1827
+	.word	1828
+	.word	1829
+	.word	1830
+	.word	1831
+	.word	1832
+	.word	1833
+	.word	1834
+	.word	1835
+	.word	1836
+	.word	1837
+	.word	1838
+	.word	1839
+	.word	1840
+	.word	1841
+	.word	1842
+	.word	1843
+	.word	1844
+	.word	1845
+	.word	1846
+	.word	1847
+	.word	1848
+	.word	1849
+	hlt	58
+	.word	1851
+	.word	1852
+	.word	1853
+	.word	1854
+	.word	1855
+	.word	1856
+	.word	1857
+	.word	1858
+	.word	1859
+	.word	1860
+	.word	1861
+	.word	1862
+	.word	1863
+	.word	1864
+	.word	1865
+	.word	1866
+	.word	1867
+	.word	1868
+	.word	1869
+	.word	1870
+	.word	1871
+	.word	1872
+	.word	1873
+	.word	1874
+	.word	1875
+	.word	1876
+	.word	1877
+	.word	1878
+	.word	1879
+	.word	1880
+	.word	1881
+	.word	1882
+	.word	1883
+	.word	1884
+	.word	1885
+	.word	1886
+	.word	1887
+	.word	1888
+	.word	1889
+	.word	1890
+	.word	1891
+	.word	1892
+	.word	1893
+	.word	1894
+	.word	1895
+	.word	1896
+	.word	1897
+	.word	1898
+	.word	end-start, 1899
+	.word	1900
+	.word	1901
+	.word	1902
+	.word	1903
+	.word	1904
+	.word	1905
+	.word	1906
+	.word	1907
+	.word	1908
+	.word	1909
+	.word	1910
+	.word	1911
+	.word	1912
+	.word	1913
+	.word	1914
+	.word	1915
+	.word	1916
+	.word	1917
+	.word	1918
+	.word	1919
+	.word	1920
+	.word	1921
+	.word	1922
+	.word	1923
+	.word	1924
+	.word	1925
+	.word	1926
+	.word	1927
+	.word	1928
+	.word	1929
+	.word	1930
+	.word	1931
+	.word	1932
+	.word	1933
+	.word	1934
+	.word	1935
+	.word	1936
+	.word	1937
+	.word	1938
+	.word	1939
+	.word	1940
+	.word	1941
+	.word	1942
+	.word	1943
+	.word	1944
+	.word	1945
+	.word	1946
+	.word	1947
+	.word	1948
+	.word	1949
+	hlt	30
+	.word	1951
+	.word	1952
+	.word	1953
+	.word	1954
+	.word	1955
+	.word	1956
+	.word	1957
+	.word	1958
+	.word	1959
+	.word	1960
+	.word	1961
+	.word	1962
+	.word	1963
+	.word	1964
+	.word	1965
+	.word	1966
+	.word	1967
+	.word	1968
+	.word	1969
+	.word	1970
+	.word	1971
+	.word	1972
+	.word	1973
+	.word	1974
+	.word	1975
+	.word	1976
+	.word	1977
+	.word	1978
+	.word	1979
+	.word	1980
+	.word	1981
+	.word	1982
+	.word	1983
+	.word	1984
+	.word	1985
+	.word	1986
+	.word	1987
+	.word	1988
+	.word	1989
+	.word	1990
+	.word	1991
+	.word	1992
+	.word	1993
+	.word	1994
+	.word	1995
+	.word	1996
+	.word	1997
+	.word	1998
+	.word	end-start, 1999
+	.word	2000
+	.word	2001
+	.word	2002
+	.word	2003
+	.word	2004
+	.word	2005
+	.word	2006
+	.word	2007
+	.word	2008
+	.word	2009
+	.word	2010
+	.word	2011
+	.word	2012
+	.word	2013
+	.word	2014
+	.word	2015
+	.word	2016
+	.word	2017
+	.word	2018
+	.word	2019
+	.word	2020
+	.word	2021
+	.word	2022
+	.word	2023
+	.word	2024
+	.word	2025
+	.word	2026
+	.word	2027
+	.word	2028
+	.word	2029
+	.word	2030
+	.word	2031
+	.word	2032
+	.word	2033
+	.word	2034
+	.word	2035
+	.word	2036
+	.word	2037
+	.word	2038
+	.word	2039
+	.word	2040
+	.word	2041
+	.word	2042
+	.word	2043
+	.word	2044
+	.word	2045
+	.word	2046
+	.word	2047
+	.word	2048
+	.word	2049
+	hlt	2
+	.word	2051
+	.word	2052
+	.word	2053
+	.word	2054
+	.word	2055
+	.word	2056
+	.word	2057
+	.word	2058
+	.word	2059
+	.word	2060
+	.word	2061
+	.word	2062
+	.word	2063
+	.word	2064
+	.word	2065
+	.word	2066
+	.word	2067
+	.word	2068
+	.word	2069
+	.word	2070
+	.word	2071
+	.word	2072
+	.word	2073
+	.word	2074
+	.word	2075
+	.word	2076
+	.word	2077
+	.word	2078
+	.word	2079
+	.word	2080
+	.word	2081
+	.word	2082
+	.word	2083
+	.word	2084
+	.word	2085
+	.word	2086
+	.word	2087
+	.word	2088
+	.word	2089
+	.word	2090
+	.word	2091
+	.word	2092
+	.word	2093
+	.word	2094
+	.word	2095
+	.word	2096
+	.word	2097
+	.word	2098
+	.word	end-start, 2099
+	.word	2100
+	.word	2101
+	.word	2102
+	.word	2103
+	.word	2104
+	.word	2105
+	.word	2106
+	.word	2107
+	.word	2108
+	.word	2109
+	.word	2110
+	.word	2111
+	.word	2112
+	.word	2113
+	.word	2114
+	.word	2115
+	.word	2116
+	.word	2117
+	.word	2118
+	.word	2119
+	.word	2120
+	.word	2121
+	.word	2122
+	.word	2123
+	.word	2124
+	.word	2125
+	.word	2126
+	.word	2127
+	.word	2128
+	.word	2129
+	.word	2130
+	.word	2131
+	.word	2132
+	.word	2133
+	.word	2134
+	.word	2135
+	.word	2136
+	.word	2137
+	.word	2138
+	.word	2139
+	.word	2140
+	.word	2141
+	.word	2142
+	.word	2143
+	.word	2144
+	.word	2145
+	.word	2146
+	.word	2147
+	.word	2148
+	.word	2149
+	hlt	38
+	.word	2151
+	.word	2152
+	.word	2153
+	.word	2154
+	.word	2155
+	.word	2156
+	.word	2157
+	.word	2158
+	.word	2159
+	.word	2160
+	.word	2161
+	.word	2162
+	.word	2163
+	.word	2164
+	.word	2165
+	.word	2166
+	.word	2167
+	.word	2168
+	.word	2169
+	.word	2170
+	.word	2171
+	.word	2172
+	.word	2173
+	.word	2174
+	.word	2175
+	.word	2176
+	.word	2177
+	.word	2178
+	.word	2179
+	.word	2180
+	.word	2181
+	.word	2182
+	.word	2183
+	.word	2184
+	.word	2185
+	.word	2186
+	.word	2187
+	.word	2188
+	.word	2189
+	.word	2190
+	.word	2191
+	.word	2192
+	.word	2193
+	.word	2194
+	.word	2195
+	.word	2196
+	.word	2197
+	.word	2198
+	.word	end-start, 2199
+	.word	2200
+	.word	2201
+	.word	2202
+	.word	2203
+	.word	2204
+	.word	2205
+	.word	2206
+	.word	2207
+	.word	2208
+	.word	2209
+	.word	2210
+	.word	2211
+	.word	2212
+	.word	2213
+	.word	2214
+	.word	2215
+	.word	2216
+	.word	2217
+	.word	2218
+	.word	2219
+	.word	2220
+	.word	2221
+	.word	2222
+	.word	2223
+	.word	2224
+	.word	2225
+	.word	2226
+	.word	2227
+	.word	2228
+	.word	2229
+	.word	2230
+	.word	2231
+	.word	2232
+	.word	2233
+	.word	2234
+	.word	2235
+	.word	2236
+	.word	2237
+	.word	2238
+	.word	2239
+	.word	2240
+	.word	2241
+	.word	2242
+	.word	2243
+	.word	2244
+	.word	2245
+	.word	2246
+	.word	2247
+	.word	2248
+	.word	2249
+	hlt	10
+	.word	2251
+	.word	2252
+	.word	2253
+	.word	2254
+	.word	2255
+	.word	2256
+	.word	2257
+	.word	2258
+	.word	2259
+	.word	2260
+	.word	2261
+	.word	2262
+	.word	2263
+	.word	2264
+	.word	2265
+	.word	2266
+	.word	2267
+	.word	2268
+	.word	2269
+	.word	2270
+	.word	2271
+	.word	2272
+	.word	2273
+	.word	2274
+	.word	2275
+	.word	2276
+	.word	2277
+	.word	2278
+	.word	2279
+	.word	2280
+	.word	2281
+	.word	2282
+	.word	2283
+	.word	2284
+	.word	2285
+	.word	2286
+	.word	2287
+	.word	2288
+	.word	2289
+	.word	2290
+	.word	2291
+	.word	2292
+	.word	2293
+	.word	2294
+	.word	2295
+	.word	2296
+	.word	2297
+	.word	2298
+	.word	end-start, 2299
+	.word	2300
+	.word	2301
+	.word	2302
+	.word	2303
+	.word	2304
+	.word	2305
+	.word	2306
+	.word	2307
+	.word	2308
+	.word	2309
+	.word	2310
+	.word	2311
+	.word	2312
+	.word	2313
+	.word	2314
+	.word	2315
+	.word	2316
+	.word	2317
+	.word	2318
+	.word	2319
+	.word	2320
+	.word	2321
+	.word	2322
+	.word	2323
+	.word	2324
+	.word	2325
+	.word	2326
+	.word	2327
+	.word	2328
+	.word	2329
+	.word	2330
+	.word	2331
+	.word	2332
+	.word	2333
+	.word	2334
+	.word	2335
+	.word	2336
+	.word	2337
+	.word	2338
+	.word	2339
+	.word	2340
+	.word	2341
+	.word	2342
+	.word	2343
+	.word	2344
+	.word	2345
+	.word	2346
+	.word	2347
+	.word	2348
+	.word	2349
+	hlt	46
+	.word	2351
+	.word	2352
+	.word	2353
+	.word	2354
+	.word	2355
+	.word	2356
+	.word	2357
+	.word	2358
+	.word	2359
+	.word	2360
+	.word	2361
+	.word	2362
+	.word	2363
+	.word	2364
+	.word	2365
+	.word	2366
+	.word	2367
+	.word	2368
+	.word	2369
+	.word	2370
+	.word	2371
+	.word	2372
+	.word	2373
+	.word	2374
+	.word	2375
+	.word	2376
+	.word	2377
+	.word	2378
+	.word	2379
+	.word	2380
+	.word	2381
+	.word	2382
+	.word	2383
+	.word	2384
+	.word	2385
+	.word	2386
+	.word	2387
+	.word	2388
+	.word	2389
+	.word	2390
+	.word	2391
+	.word	2392
+	.word	2393
+	.word	2394
+	.word	2395
+	.word	2396
+	.word	2397
+	.word	2398
+	.word	end-start, 2399
+	.word	2400
+	.word	2401
+	.word	2402
+	.word	2403
+	.word	2404
+	.word	2405
+	.word	2406
+	.word	2407
+	.word	2408
+	.word	2409
+	.word	2410
+	.word	2411
+	.word	2412
+	.word	2413
+	.word	2414
+	.word	2415
+	.word	2416
+	.word	2417
+	.word	2418
+	.word	2419
+	.word	2420
+	.word	2421
+	.word	2422
+	.word	2423
+	.word	2424
+	.word	2425
+	.word	2426
+	.word	2427
+	.word	2428
+	.word	2429
+	.word	2430
+	.word	2431
+	.word	2432
+	.word	2433
+	.word	2434
+	.word	2435
+	.word	2436
+	.word	2437
+	.word	2438
+	.word	2439
+	.word	2440
+	.word	2441
+	.word	2442
+	.word	2443
+	.word	2444
+	.word	2445
+	.word	2446
+	.word	2447
+	.word	2448
+	.word	2449
+	hlt	18
+	.word	2451
+	.word	2452
+	.word	2453
+	.word	2454
+	.word	2455
+	.word	2456
+	.word	2457
+	.word	2458
+	.word	2459
+	.word	2460
+	.word	2461
+	.word	2462
+	.word	2463
+	.word	2464
+	.word	2465
+	.word	2466
+	.word	2467
+	.word	2468
+	.word	2469
+	.word	2470
+	.word	2471
+	.word	2472
+	.word	2473
+	.word	2474
+	.word	2475
+	.word	2476
+	.word	2477
+	.word	2478
+	.word	2479
+	.word	2480
+	.word	2481
+	.word	2482
+	.word	2483
+	.word	2484
+	.word	2485
+	.word	2486
+	.word	2487
+	.word	2488
+	.word	2489
+	.word	2490
+	.word	2491
+	.word	2492
+	.word	2493
+	.word	2494
+	.word	2495
+	.word	2496
+	.word	2497
+	.word	2498
+	.word	end-start, 2499
+	.word	2500
+	.word	2501
+	.word	2502
+	.word	2503
+	.word	2504
+	.word	2505
+	.word	2506
+	.word	2507
+	.word	2508
+	.word	2509
+	.word	2510
+	.word	2511
+	.word	2512
+	.word	2513
+	.word	2514
+	.word	2515
+	.word	2516
+	.word	2517
+	.word	2518
+	.word	2519
+	.word	2520
+	.word	2521
+	.word	2522
+	.word	2523
+	.word	2524
+	.word	2525
+	.word	2526
+	.word	2527
+	.word	2528
+	.word	2529
+	.word	2530
+	.word	2531
+	.word	2532
+	.word	2533
+	.word	2534
+	.word	2535
+	.word	2536
+	.word	2537
+	.word	2538
+	.word	2539
+	.word	2540
+	.word	2541
+	.word	2542
+	.word	2543
+	.word	2544
+	.word	2545
+	.word	2546
+	.word	2547
+	.word	2548
+	.word	2549
+	hlt	54
+	.word	2551
+	.word	2552
+	.word	2553
+	.word	2554
+	.word	2555
+	.word	2556
+	.word	2557
+	.word	2558
+	.word	2559
+	.word	2560
+	.word	2561
+	.word	2562
+	.word	2563
+	.word	2564
+	.word	2565
+	.word	2566
+	.word	2567
+	.word	2568
+	.word	2569
+	.word	2570
+	.word	2571
+	.word	2572
+	.word	2573
+	.word	2574
+	.word	2575
+	.word	2576
+	.word	2577
+	.word	2578
+	.word	2579
+	.word	2580
+	.word	2581
+	.word	2582
+	.word	2583
+	.word	2584
+	.word	2585
+	.word	2586
+	.word	2587
+	.word	2588
+	.word	2589
+	.word	2590
+	.word	2591
+	.word	2592
+	.word	2593
+	.word	2594
+	.word	2595
+	.word	2596
+	.word	2597
+	.word	2598
+	.word	end-start, 2599
+	.word	2600
+	.word	2601
+	.word	2602
+	.word	2603
+	.word	2604
+	.word	2605
+	.word	2606
+	.word	2607
+	.word	2608
+	.word	2609
+	.word	2610
+	.word	2611
+	.word	2612
+	.word	2613
+	.word	2614
+	.word	2615
+	.word	2616
+	.word	2617
+	.word	2618
+	.word	2619
+	.word	2620
+	.word	2621
+	.word	2622
+	.word	2623
+	.word	2624
+	.word	2625
+	.word	2626
+	.word	2627
+	.word	2628
+	.word	2629
+	.word	2630
+	.word	2631
+	.word	2632
+	.word	2633
+	.word	2634
+	.word	2635
+	.word	2636
+	.word	2637
+	.word	2638
+	.word	2639
+	.word	2640
+	.word	2641
+	.word	2642
+	.word	2643
+	.word	2644
+	.word	2645
+	.word	2646
+	.word	2647
+	.word	2648
+	.word	2649
+	hlt	26
+	.word	2651
+	.word	2652
+	.word	2653
+	.word	2654
+	.word	2655
+	.word	2656
+	.word	2657
+	.word	2658
+	.word	2659
+	.word	2660
+	.word	2661
+	.word	2662
+	.word	2663
+	.word	2664
+	.word	2665
+	.word	2666
+	.word	2667
+	.word	2668
+	.word	2669
+	.word	2670
+	.word	2671
+	.word	2672
+	.word	2673
+	.word	2674
+	.word	2675
+	.word	2676
+	.word	2677
+	.word	2678
+	.word	2679
+	.word	2680
+	.word	2681
+	.word	2682
+	.word	2683
+	.word	2684
+	.word	2685
+	.word	2686
+	.word	2687
+	.word	2688
+	.word	2689
+	.word	2690
+	.word	2691
+	.word	2692
+	.word	2693
+	.word	2694
+	.word	2695
+	.word	2696
+	.word	2697
+	.word	2698
+	.word	end-start, 2699
+	.word	2700
+	.word	2701
+	.word	2702
+	.word	2703
+	.word	2704
+	.word	2705
+	.word	2706
+	.word	2707
+	.word	2708
+	.word	2709
+	.word	2710
+	.word	2711
+	.word	2712
+	.word	2713
+	.word	2714
+	.word	2715
+	.word	2716
+	.word	2717
+	.word	2718
+	.word	2719
+	.word	2720
+	.word	2721
+	.word	2722
+	.word	2723
+	.word	2724
+	.word	2725
+	.word	2726
+	.word	2727
+	.word	2728
+	.word	2729
+	.word	2730
+	.word	2731
+	.word	2732
+	.word	2733
+	.word	2734
+	.word	2735
+	.word	2736
+	.word	2737
+	.word	2738
+	.word	2739
+	.word	2740
+	.word	2741
+	.word	2742
+	.word	2743
+	.word	2744
+	.word	2745
+	.word	2746
+	.word	2747
+	.word	2748
+	.word	2749
+	hlt	62
+	.word	2751
+	.word	2752
+	.word	2753
+	.word	2754
+	.word	2755
+	.word	2756
+	.word	2757
+	.word	2758
+	.word	2759
+	.word	2760
+	.word	2761
+	.word	2762
+	.word	2763
+	.word	2764
+	.word	2765
+	.word	2766
+	.word	2767
+	.word	2768
+	.word	2769
+	.word	2770
+	.word	2771
+	.word	2772
+	.word	2773
+	.word	2774
+	.word	2775
+	.word	2776
+	.word	2777
+	.word	2778
+	.word	2779
+	.word	2780
+	.word	2781
+	.word	2782
+	.word	2783
+	.word	2784
+	.word	2785
+	.word	2786
+	.word	2787
+	.word	2788
+	.word	2789
+	.word	2790
+	.word	2791
+	.word	2792
+	.word	2793
+	.word	2794
+	.word	2795
+	.word	2796
+	.word	2797
+	.word	2798
+	.word	end-start, 2799
+	.word	2800
+	.word	2801
+	.word	2802
+	.word	2803
+	.word	2804
+	.word	2805
+	.word	2806
+	.word	2807
+	.word	2808
+	.word	2809
+	.word	2810
+	.word	2811
+	.word	2812
+	.word	2813
+	.word	2814
+	.word	2815
+	.word	2816
+	.word	2817
+	.word	2818
+	.word	2819
+	.word	2820
+	.word	2821
+	.word	2822
+	.word	2823
+	.word	2824
+	.word	2825
+	.word	2826
+	.word	2827
+	.word	2828
+	.word	2829
+	.word	2830
+	.word	2831
+	.word	2832
+	.word	2833
+	.word	2834
+	.word	2835
+	.word	2836
+	.word	2837
+	.word	2838
+	.word	2839
+	.word	2840
+	.word	2841
+	.word	2842
+	.word	2843
+	.word	2844
+	.word	2845
+	.word	2846
+	.word	2847
+	.word	2848
+	.word	2849
+	hlt	34
+	.word	2851
+	.word	2852
+	.word	2853
+	.word	2854
+	.word	2855
+	.word	2856
+	.word	2857
+	.word	2858
+	.word	2859
+	.word	2860
+	.word	2861
+	.word	2862
+	.word	2863
+	.word	2864
+	.word	2865
+	.word	2866
+	.word	2867
+	.word	2868
+	.word	2869
+	.word	2870
+	.word	2871
+	.word	2872
+	.word	2873
+	.word	2874
+	.word	2875
+	.word	2876
+	.word	2877
+	.word	2878
+	.word	2879
+	.word	2880
+	.word	2881
+	.word	2882
+	.word	2883
+	.word	2884
+	.word	2885
+	.word	2886
+	.word	2887
+	.word	2888
+	.word	2889
+	.word	2890
+	.word	2891
+	.word	2892
+	.word	2893
+	.word	2894
+	.word	2895
+	.word	2896
+	.word	2897
+	.word	2898
+	.word	end-start, 2899
+	.word	2900
+	.word	2901
+	.word	2902
+	.word	2903
+	.word	2904
+	.word	2905
+	.word	2906
+	.word	2907
+	.word	2908
+	.word	2909
+	.word	2910
+	.word	2911
+	.word	2912
+	.word	2913
+	.word	2914
+	.word	2915
+	.word	2916
+	.word	2917
+	.word	2918
+	.word	2919
+	.word	2920
+	.word	2921
+	.word	2922
+	.word	2923
+	.word	2924
+	.word	2925
+	.word	2926
+	.word	2927
+	.word	2928
+	.word	2929
+	.word	2930
+	.word	2931
+	.word	2932
+	.word	2933
+	.word	2934
+	.word	2935
+	.word	2936
+	.word	2937
+	.word	2938
+	.word	2939
+	.word	2940
+	.word	2941
+	.word	2942
+	.word	2943
+	.word	2944
+	.word	2945
+	.word	2946
+	.word	2947
+	.word	2948
+	.word	2949
+	hlt	6
+	.word	2951
+	.word	2952
+	.word	2953
+	.word	2954
+	.word	2955
+	.word	2956
+	.word	2957
+	.word	2958
+	.word	2959
+	.word	2960
+	.word	2961
+	.word	2962
+	.word	2963
+	.word	2964
+	.word	2965
+	.word	2966
+	.word	2967
+	.word	2968
+	.word	2969
+	.word	2970
+	.word	2971
+	.word	2972
+	.word	2973
+	.word	2974
+	.word	2975
+	.word	2976
+	.word	2977
+	.word	2978
+	.word	2979
+	.word	2980
+	.word	2981
+	.word	2982
+	.word	2983
+	.word	2984
+	.word	2985
+	.word	2986
+	.word	2987
+	.word	2988
+	.word	2989
+	.word	2990
+	.word	2991
+	.word	2992
+	.word	2993
+	.word	2994
+	.word	2995
+	.word	2996
+	.word	2997
+	.word	2998
+	.word	end-start, 2999
+	.word	3000
+	.word	3001
+	.word	3002
+	.word	3003
+	.word	3004
+	.word	3005
+	.word	3006
+	.word	3007
+	.word	3008
+	.word	3009
+	.word	3010
+	.word	3011
+	.word	3012
+	.word	3013
+	.word	3014
+	.word	3015
+	.word	3016
+	.word	3017
+	.word	3018
+	.word	3019
+	.word	3020
+	.word	3021
+	.word	3022
+	.word	3023
+	.word	3024
+	.word	3025
+	.word	3026
+	.word	3027
+	.word	3028
+	.word	3029
+	.word	3030
+	.word	3031
+	.word	3032
+	.word	3033
+	.word	3034
+	.word	3035
+	.word	3036
+	.word	3037
+	.word	3038
+	.word	3039
+	.word	3040
+	.word	3041
+	.word	3042
+	.word	3043
+	.word	3044
+	.word	3045
+	.word	3046
+	.word	3047
+	.word	3048
+	.word	3049
+	hlt	42
+	.word	3051
+	.word	3052
+	.word	3053
+	.word	3054
+	.word	3055
+	.word	3056
+	.word	3057
+	.word	3058
+	.word	3059
+	.word	3060
+	.word	3061
+	.word	3062
+	.word	3063
+	.word	3064
+	.word	3065
+	.word	3066
+	.word	3067
+	.word	3068
+	.word	3069
+	.word	3070
+	.word	3071
+	.word	3072
+	.word	3073
+	.word	3074
+	.word	3075
+	.word	3076
+	.word	3077
+	.word	3078
+	.word	3079
+	.word	3080
+	.word	3081
+	.word	3082
+	.word	3083
+	.word	3084
+	.word	3085
+	.word	3086
+	.word	3087
+	.word	3088
+	.word	3089
+	.word	3090
+	.word	3091
+	.word	3092
+	.word	3093
+	.word	3094
+	.word	3095
+	.word	3096
+	.word	3097
+	.word	3098
+	.word	end-start, 3099
+	.word	3100
+	.word	3101
+	.word	3102
+	.word	3103
+	.word	3104
+	.word	3105
+	.word	3106
+	.word	3107
+	.word	3108
+	.word	3109
+	.word	3110
+	.word	3111
+	.word	3112
+	.word	3113
+	.word	3114
+	.word	3115
+	.word	3116
+	.word	3117
+	.word	3118
+	.word	3119
+	.word	3120
+	.word	3121
+	.word	3122
+	.word	3123
+	.word	3124
+	.word	3125
+	.word	3126
+	.word	3127
+	.word	3128
+	.word	3129
+	.word	3130
+	.word	3131
+	.word	3132
+	.word	3133
+	.word	3134
+	.word	3135
+	.word	3136
+	.word	3137
+	.word	3138
+	.word	3139
+	.word	3140
+	.word	3141
+	.word	3142
+	.word	3143
+	.word	3144
+	.word	3145
+	.word	3146
+	.word	3147
+	.word	3148
+	.word	3149
+	hlt	14
+	.word	3151
+	.word	3152
+	.word	3153
+	.word	3154
+	.word	3155
+	.word	3156
+	.word	3157
+	.word	3158
+	.word	3159
+	.word	3160
+	.word	3161
+	.word	3162
+	.word	3163
+	.word	3164
+	.word	3165
+	.word	3166
+	.word	3167
+	.word	3168
+	.word	3169
+	.word	3170
+	.word	3171
+	.word	3172
+	.word	3173
+	.word	3174
+	.word	3175
+	.word	3176
+	.word	3177
+	.word	3178
+	.word	3179
+	.word	3180
+	.word	3181
+	.word	3182
+	.word	3183
+	.word	3184
+	.word	3185
+	.word	3186
+	.word	3187
+	.word	3188
+	.word	3189
+	.word	3190
+	.word	3191
+	.word	3192
+	.word	3193
+	.word	3194
+	.word	3195
+	.word	3196
+	.word	3197
+	.word	3198
+	.word	end-start, 3199
+	.word	3200
+	.word	3201
+	.word	3202
+	.word	3203
+	.word	3204
+	.word	3205
+	.word	3206
+	.word	3207
+	.word	3208
+	.word	3209
+	.word	3210
+	.word	3211
+	.word	3212
+	.word	3213
+	.word	3214
+	.word	3215
+	.word	3216
+	.word	3217
+	.word	3218
+	.word	3219
+	.word	3220
+	.word	3221
+	.word	3222
+	.word	3223
+	.word	3224
+	.word	3225
+	.word	3226
+	.word	3227
+	.word	3228
+	.word	3229
+	.word	3230
+	.word	3231
+	.word	3232
+	.word	3233
+	.word	3234
+	.word	3235
+	.word	3236
+	.word	3237
+	.word	3238
+	.word	3239
+	.word	3240
+	.word	3241
+	.word	3242
+	.word	3243
+	.word	3244
+	.word	3245
+	.word	3246
+	.word	3247
+	.word	3248
+	.word	3249
+	hlt	50
+	.word	3251
+	.word	3252
+	.word	3253
+	.word	3254
+	.word	3255
+	.word	3256
+	.word	3257
+	.word	3258
+	.word	3259
+	.word	3260
+	.word	3261
+	.word	3262
+	.word	3263
+	.word	3264
+	.word	3265
+	.word	3266
+	.word	3267
+	.word	3268
+	.word	3269
+	.word	3270
+	.word	3271
+	.word	3272
+	.word	3273
+	.word	3274
+	.word	3275
+	.word	3276
+	.word	3277
+	.word	3278
+	.word	3279
+	.word	3280
+	.word	3281
+	.word	3282
+	.word	3283
+	.word	3284
+	.word	3285
+	.word	3286
+	.word	3287
+	.word	3288
+	.word	3289
+	.word	3290
+	.word	3291
+	.word	3292
+	.word	3293
+	.word	3294
+	.word	3295
+	.word	3296
+	.word	3297
+	.word	3298
+	.word	end-start, 3299
+	.word	3300
+	.word	3301
+	.word	3302
+	.word	3303
+	.word	3304
+	.word	3305
+	.word	3306
+	.word	3307
+	.word	3308
+	.word	3309
+	.word	3310
+	.word	3311
+	.word	3312
+	.word	3313
+	.word	3314
+	.word	3315
+	.word	3316
+	.word	3317
+	.word	3318
+	.word	3319
+	.word	3320
+	.word	3321
+	.word	3322
+	.word	3323
+	.word	3324
+	.word	3325
+	.word	3326
+	.word	3327
+	.word	3328
+	.word	3329
+	.word	3330
+	.word	3331
+	.word	3332
+	.word	3333
+	.word	3334
+	.word	3335
+	.word	3336
+	.word	3337
+	.word	3338
+	.word	3339
+	.word	3340
+	.word	3341
+	.word	3342
+	.word	3343
+	.word	3344
+	.word	3345
+	.word	3346
+	.word	3347
+	.word	3348
+	.word	3349
+	hlt	22
+	.word	3351
+	.word	3352
+	.word	3353
+	.word	3354
+	.word	3355
+	.word	3356
+	.word	3357
+	.word	3358
+	.word	3359
+	.word	3360
+	.word	3361
+	.word	3362
+	.word	3363
+	.word	3364
+	.word	3365
+	.word	3366
+	.word	3367
+	.word	3368
+	.word	3369
+	.word	3370
+	.word	3371
+	.word	3372
+	.word	3373
+	.word	3374
+	.word	3375
+	.word	3376
+	.word	3377
+	.word	3378
+	.word	3379
+	.word	3380
+	.word	3381
+	.word	3382
+	.word	3383
+	.word	3384
+	.word	3385
+	.word	3386
+	.word	3387
+	.word	3388
+	.word	3389
+	.word	3390
+	.word	3391
+	.word	3392
+	.word	3393
+	.word	3394
+	.word	3395
+	.word	3396
+	.word	3397
+	.word	3398
+	.word	end-start, 3399
+	.word	3400
+	.word	3401
+	.word	3402
+	.word	3403
+	.word	3404
+	.word	3405
+	.word	3406
+	.word	3407
+	.word	3408
+	.word	3409
+	.word	3410
+	.word	3411
+	.word	3412
+	.word	3413
+	.word	3414
+	.word	3415
+	.word	3416
+	.word	3417
+	.word	3418
+	.word	3419
+	.word	3420
+	.word	3421
+	.word	3422
+	.word	3423
+	.word	3424
+	.word	3425
+	.word	3426
+	.word	3427
+	.word	3428
+	.word	3429
+	.word	3430
+	.word	3431
+	.word	3432
+	.word	3433
+	.word	3434
+	.word	3435
+	.word	3436
+	.word	3437
+	.word	3438
+	.word	3439
+	.word	3440
+	.word	3441
+	.word	3442
+	.word	3443
+	.word	3444
+	.word	3445
+	.word	3446
+	.word	3447
+	.word	3448
+	.word	3449
+	hlt	58
+	.word	3451
+	.word	3452
+	.word	3453
+	.word	3454
+	.word	3455
+	.word	3456
+	.word	3457
+	.word	3458
+	.word	3459
+	.word	3460
+	.word	3461
+	.word	3462
+	.word	3463
+	.word	3464
+	.word	3465
+	.word	3466
+	.word	3467
+	.word	3468
+	.word	3469
+	.word	3470
+	.word	3471
+	.word	3472
+	.word	3473
+	.word	3474
+	.word	3475
+	.word	3476
+	.word	3477
+	.word	3478
+	.word	3479
+	.word	3480
+	.word	3481
+	.word	3482
+	.word	3483
+	.word	3484
+	.word	3485
+	.word	3486
+	.word	3487
+	.word	3488
+	.word	3489
+	.word	3490
+	.word	3491
+	.word	3492
+	.word	3493
+	.word	3494
+	.word	3495
+	.word	3496
+	.word	3497
+	.word	3498
+	.word	end-start, 3499
+	.word	3500
+	.word	3501
+	.word	3502
+	.word	3503
+	.word	3504
+	.word	3505
+	.word	3506
+	.word	3507
+	.word	3508
+	.word	3509
+	.word	3510
+	.word	3511
+	.word	3512
+	.word	3513
+	.word	3514
+	.word	3515
+	.word	3516
+	.word	3517
+	.word	3518
+	.word	3519
+	.word	3520
+	.word	3521
+	.word	3522
+	.word	3523
+	.word	3524
+	.word	3525
+	.word	3526
+	.word	3527
+	.word	3528
+	.word	3529
+	.word	3530
+	.word	3531
+	.word	3532
+	.word	3533
+	.word	3534
+	.word	3535
+	.word	3536
+	.word	3537
+	.word	3538
+	.word	3539
+	.word	3540
+	.word	3541
+	.word	3542
+	.word	3543
+	.word	3544
+	.word	3545
+	.word	3546
+	.word	3547
+	.word	3548
+	.word	3549
+	hlt	30
+	.word	3551
+	.word	3552
+	.word	3553
+	.word	3554
+	.word	3555
+	.word	3556
+	.word	3557
+	.word	3558
+	.word	3559
+	.word	3560
+	.word	3561
+	.word	3562
+	.word	3563
+	.word	3564
+	.word	3565
+	.word	3566
+	.word	3567
+	.word	3568
+	.word	3569
+	.word	3570
+	.word	3571
+	.word	3572
+	.word	3573
+	.word	3574
+	.word	3575
+	.word	3576
+	.word	3577
+	.word	3578
+	.word	3579
+	.word	3580
+	.word	3581
+	.word	3582
+	.word	3583
+	.word	3584
+	.word	3585
+	.word	3586
+	.word	3587
+	.word	3588
+	.word	3589
+	.word	3590
+	.word	3591
+	.word	3592
+	.word	3593
+	.word	3594
+	.word	3595
+	.word	3596
+	.word	3597
+	.word	3598
+	.word	end-start, 3599
+	blc	0xff01
+	.word	3601
+	.word	3602
+	.word	3603
+	.word	3604
+	.word	3605
+	.word	3606
+	.word	3607
+	.word	3608
+	.word	3609
+	.word	3610
+	.word	3611
+	.word	3612
+	.word	3613
+	.word	3614
+	.word	3615
+	.word	3616
+	.word	3617
+	.word	3618
+	.word	3619
+	.word	3620
+	.word	3621
+	.word	3622
+	.word	3623
+	.word	3624
+	.word	3625
+	.word	3626
+	.word	3627
+	.word	3628
+	.word	3629
+	.word	3630
+	.word	3631
+	.word	3632
+	.word	3633
+	.word	3634
+	.word	3635
+	.word	3636
+	.word	3637
+	.word	3638
+	.word	3639
+	.word	3640
+	.word	3641
+	.word	3642
+	.word	3643
+	.word	3644
+	.word	3645
+	.word	3646
+	.word	3647
+	.word	3648
+	.word	3649
+	hlt	2
+	.word	3651
+	.word	3652
+	.word	3653
+	.word	3654
+	.word	3655
+	.word	3656
+	.word	3657
+	.word	3658
+	.word	3659
+	.word	3660
+	.word	3661
+	.word	3662
+	.word	3663
+	.word	3664
+	.word	3665
+	.word	3666
+	.word	3667
+	.word	3668
+	.word	3669
+	.word	3670
+	.word	3671
+	.word	3672
+	.word	3673
+	.word	3674
+	.word	3675
+	.word	3676
+	.word	3677
+	.word	3678
+	.word	3679
+	.word	3680
+	.word	3681
+	.word	3682
+	.word	3683
+	.word	3684
+	.word	3685
+	.word	3686
+	.word	3687
+	.word	3688
+	.word	3689
+	.word	3690
+	.word	3691
+	.word	3692
+	.word	3693
+	.word	3694
+	.word	3695
+	.word	3696
+	.word	3697
+	.word	3698
+	.word	end-start, 3699
+	.word	3700
+	.word	3701
+	.word	3702
+	.word	3703
+	.word	3704
+	.word	3705
+	.word	3706
+	.word	3707
+	.word	3708
+	.word	3709
+	.word	3710
+	.word	3711
+	.word	3712
+	.word	3713
+	.word	3714
+	.word	3715
+	.word	3716
+	.word	3717
+	.word	3718
+	.word	3719
+	.word	3720
+	.word	3721
+	.word	3722
+	.word	3723
+	.word	3724
+	.word	3725
+	.word	3726
+	.word	3727
+	.word	3728
+	.word	3729
+	.word	3730
+	.word	3731
+	.word	3732
+	.word	3733
+	.word	3734
+	.word	3735
+	.word	3736
+	.word	3737
+	.word	3738
+	.word	3739
+	.word	3740
+	.word	3741
+	.word	3742
+	.word	3743
+	.word	3744
+	.word	3745
+	.word	3746
+	.word	3747
+	.word	3748
+	.word	3749
+	hlt	38
+	.word	3751
+	.word	3752
+	.word	3753
+	.word	3754
+	.word	3755
+	.word	3756
+	.word	3757
+	.word	3758
+	.word	3759
+	.word	3760
+	.word	3761
+	.word	3762
+	.word	3763
+	.word	3764
+	.word	3765
+	.word	3766
+	.word	3767
+	.word	3768
+	.word	3769
+	.word	3770
+	.word	3771
+	.word	3772
+	.word	3773
+	.word	3774
+	.word	3775
+	.word	3776
+	.word	3777
+	.word	3778
+	.word	3779
+	.word	3780
+	.word	3781
+	.word	3782
+	.word	3783
+	.word	3784
+	.word	3785
+	.word	3786
+	.word	3787
+	.word	3788
+	.word	3789
+	.word	3790
+	.word	3791
+	.word	3792
+	.word	3793
+	.word	3794
+	.word	3795
+	.word	3796
+	.word	3797
+	.word	3798
+	.word	end-start, 3799
+	.word	3800
+	.word	3801
+	.word	3802
+	.word	3803
+	.word	3804
+	.word	3805
+	.word	3806
+	.word	3807
+	.word	3808
+	.word	3809
+	.word	3810
+	.word	3811
+	.word	3812
+	.word	3813
+	.word	3814
+	.word	3815
+	.word	3816
+	.word	3817
+	.word	3818
+	.word	3819
+	.word	3820
+	.word	3821
+	.word	3822
+	.word	3823
+	.word	3824
+	.word	3825
+	.word	3826
+	.word	3827
+	.word	3828
+	.word	3829
+	.word	3830
+	.word	3831
+	.word	3832
+	.word	3833
+	.word	3834
+	.word	3835
+	.word	3836
+	.word	3837
+	.word	3838
+	.word	3839
+	.word	3840
+	.word	3841
+	.word	3842
+	.word	3843
+	.word	3844
+	.word	3845
+	.word	3846
+	.word	3847
+	.word	3848
+	.word	3849
+	hlt	10
+	.word	3851
+	.word	3852
+	.word	3853
+	.word	3854
+	.word	3855
+	.word	3856
+	.word	3857
+	.word	3858
+	.word	3859
+	.word	3860
+	.word	3861
+	.word	3862
+	.word	3863
+	.word	3864
+	.word	3865
+	.word	3866
+	.word	3867
+	.word	3868
+	.word	3869
+	.word	3870
+	.word	3871
+	.word	3872
+	.word	3873
+	.word	3874
+	.word	3875
+	.word	3876
+	.word	3877
+	.word	3878
+	.word	3879
+	.word	3880
+	.word	3881
+	.word	3882
+	.word	3883
+	.word	3884
+	.word	3885
+	.word	3886
+	.word	3887
+	.word	3888
+	.word	3889
+	.word	3890
+	.word	3891
+	.word	3892
+	.word	3893
+	.word	3894
+	.word	3895
+	.word	3896
+	.word	3897
+	.word	3898
+	.word	end-start, 3899
+	.word	3900
+	.word	3901
+	.word	3902
+	.word	3903
+	.word	3904
+	.word	3905
+	.word	3906
+	.word	3907
+	.word	3908
+	.word	3909
+	.word	3910
+	.word	3911
+	.word	3912
+	.word	3913
+	.word	3914
+	.word	3915
+	.word	3916
+	.word	3917
+	.word	3918
+	.word	3919
+	.word	3920
+	.word	3921
+	.word	3922
+	.word	3923
+	.word	3924
+	.word	3925
+	.word	3926
+	.word	3927
+	.word	3928
+	.word	3929
+	.word	3930
+	.word	3931
+	.word	3932
+	.word	3933
+	.word	3934
+	.word	3935
+	.word	3936
+	.word	3937
+	.word	3938
+	.word	3939
+	.word	3940
+	.word	3941
+	.word	3942
+	.word	3943
+	.word	3944
+	.word	3945
+	.word	3946
+	.word	3947
+	.word	3948
+	.word	3949
+	hlt	46
+	.word	3951
+	.word	3952
+	.word	3953
+	.word	3954
+	.word	3955
+	.word	3956
+	.word	3957
+	.word	3958
+	.word	3959
+	.word	3960
+	.word	3961
+	.word	3962
+	.word	3963
+	.word	3964
+	.word	3965
+	.word	3966
+	.word	3967
+	.word	3968
+	.word	3969
+	.word	3970
+	.word	3971
+	.word	3972
+	.word	3973
+	.word	3974
+	.word	3975
+	.word	3976
+	.word	3977
+	.word	3978
+	.word	3979
+	.word	3980
+	.word	3981
+	.word	3982
+	.word	3983
+	.word	3984
+	.word	3985
+	.word	3986
+	.word	3987
+	.word	3988
+	.word	3989
+	.word	3990
+	.word	3991
+	.word	3992
+	.word	3993
+	.word	3994
+	.word	3995
+	.word	3996
+	.word	3997
+	.word	3998
+	.word	end-start, 3999
+	.word	4000
+	.word	4001
+	.word	4002
+	.word	4003
+	.word	4004
+	.word	4005
+	.word	4006
+	.word	4007
+	.word	4008
+	.word	4009
+	.word	4010
+	.word	4011
+	.word	4012
+	.word	4013
+	.word	4014
+	.word	4015
+	.word	4016
+	.word	4017
+	.word	4018
+	.word	4019
+	.word	4020
+	.word	4021
+	.word	4022
+	.word	4023
+	.word	4024
+	.word	4025
+	.word	4026
+	.word	4027
+	.word	4028
+	.word	4029
+	.word	4030
+	.word	4031
+	.word	4032
+	.word	4033
+	.word	4034
+	.word	4035
+	.word	4036
+	.word	4037
+	.word	4038
+	.word	4039
+	.word	4040
+	.word	4041
+	.word	4042
+	.word	4043
+	.word	4044
+	.word	4045
+	.word	4046
+	.word	4047
+	.word	4048
+	.word	4049
+	hlt	18
+	.word	4051
+	.word	4052
+	.word	4053
+	.word	4054
+	.word	4055
+	.word	4056
+	.word	4057
+	.word	4058
+	.word	4059
+	.word	4060
+	.word	4061
+	.word	4062
+	.word	4063
+	.word	4064
+	.word	4065
+	.word	4066
+	.word	4067
+	.word	4068
+	.word	4069
+	.word	4070
+	.word	4071
+	.word	4072
+	.word	4073
+	.word	4074
+	.word	4075
+	.word	4076
+	.word	4077
+	.word	4078
+	.word	4079
+	.word	4080
+	.word	4081
+	.word	4082
+	.word	4083
+	.word	4084
+	.word	4085
+	.word	4086
+	.word	4087
+	.word	4088
+	.word	4089
+	.word	4090
+	.word	4091
+	.word	4092
+	.word	4093
+	.word	4094
+	.word	4095
+	.word	4096
+	.word	4097
+	.word	4098
+	.word	end-start, 4099
+	.word	4100
+	.word	4101
+	.word	4102
+	.word	4103
+	.word	4104
+	.word	4105
+	.word	4106
+	.word	4107
+	.word	4108
+	.word	4109
+	.word	4110
+	.word	4111
+	.word	4112
+	.word	4113
+	.word	4114
+	.word	4115
+	.word	4116
+	.word	4117
+	.word	4118
+	.word	4119
+	.word	4120
+	.word	4121
+	.word	4122
+	.word	4123
+	.word	4124
+	.word	4125
+	.word	4126
+	.word	4127
+	.word	4128
+	.word	4129
+	.word	4130
+	.word	4131
+	.word	4132
+	.word	4133
+	.word	4134
+	.word	4135
+	.word	4136
+	.word	4137
+	.word	4138
+	.word	4139
+	.word	4140
+	.word	4141
+	.word	4142
+	.word	4143
+	.word	4144
+	.word	4145
+	.word	4146
+	.word	4147
+	.word	4148
+	.word	4149
+	hlt	54
+	.word	4151
+	.word	4152
+	.word	4153
+	.word	4154
+	.word	4155
+	.word	4156
+	.word	4157
+	.word	4158
+	.word	4159
+	.word	4160
+	.word	4161
+	.word	4162
+	.word	4163
+	.word	4164
+	.word	4165
+	.word	4166
+	.word	4167
+	.word	4168
+	.word	4169
+	.word	4170
+	.word	4171
+	.word	4172
+	.word	4173
+	.word	4174
+	.word	4175
+	.word	4176
+	.word	4177
+	.word	4178
+	.word	4179
+	.word	4180
+	.word	4181
+	.word	4182
+	.word	4183
+	.word	4184
+	.word	4185
+	.word	4186
+	.word	4187
+	.word	4188
+	.word	4189
+	.word	4190
+	.word	4191
+	.word	4192
+	.word	4193
+	.word	4194
+	.word	4195
+	.word	4196
+	.word	4197
+	.word	4198
+	.word	end-start, 4199
+end:
@@ -0,0 +1,4 @@
+	lw	r1, 1
+	.entry	start
+start:	hlt	0
+	.entry	start+1
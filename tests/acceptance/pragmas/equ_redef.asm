@@ -0,0 +1,6 @@
+.equ v 1
+.word v
+.equ v 2
+.word v
+.equ v v+1
+.word v, .
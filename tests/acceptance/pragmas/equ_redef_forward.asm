@@ -0,0 +1,6 @@
+.equ v 1
+.word v+f
+.equ a v+f
+.equ v 2
+.word a
+f: .word v
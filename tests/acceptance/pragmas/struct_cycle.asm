@@ -0,0 +1,7 @@
+.word A
+.struct A:
+a1: .res B
+.endstruct
+.struct B:
+b1: .res A
+.endstruct
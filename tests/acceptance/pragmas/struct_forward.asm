@@ -0,0 +1,13 @@
+.word A, B, C
+.struct A:
+a1: .res 1
+a2: .res B
+.endstruct
+.struct B:
+b1: .res C
+.endstruct
+.struct C:
+c1: .res 3
+c2: .res 1
+.endstruct
+.word a2, c2
@@ -0,0 +1,4 @@
+.word -1, 65535, a, ., -32768
+.word ., b, 2.5
+.equ a 5
+.equ b -2
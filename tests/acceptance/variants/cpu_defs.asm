@@ -0,0 +1,9 @@
+; emas-test: -V mx16:-cmx16,-DBIG
+; emas-test: -V mera400:-cmera400,-DSIZE=3
+; emas-test: -V broken:-cmera400,-DBIG,-DSIZE=5
+	.ifdef	BIG
+	cron
+	.else
+	.word	SIZE
+	.endif
+	.word	.
@@ -0,0 +1,6 @@
+; emas-test: -V a:-DX=1 -V b:-DX=2
+start:	ujs	.fwd
+.fwd:	.word	.fwd, other.x, start.fwd
+other:	.word	.x
+.x:	.word	start.fwd
+	.word	X, start.fwd, .x
@@ -21,6 +21,8 @@ fi
 
 EMDAS=$(which emdas)
 BASEDIR=$1
+JOBS=$(nproc 2>/dev/null || echo 1)
+OUTDIR=$(mktemp -d)
 TESTDIRS="addr alu args barnb cycle int mem mod multix ops registers vendor"
 
 echo "Testing assembly with: $EMAS"
@@ -39,19 +41,26 @@ for tests in $TESTDIRS ; do
 		echo "Missing tests"
 		exit 1
 	fi
+	# assemble the whole directory in one go
+	rm -f $OUTDIR/*.bin
+	for file in $files ; do
+		echo "$file $OUTDIR/$(basename $file .asm).bin"
+	done > $OUTDIR/batch.list
+	$EMAS --batch -j $JOBS -I ../asminc -Oraw -I $BASEDIR/include @$OUTDIR/batch.list
 	for file in $files ; do
 		test_name=$(basename $file)
+		bin=$OUTDIR/$(basename $file .asm).bin
 		echo -n "$test_name "
-		$EMAS -I ../asminc -Oraw -o /tmp/emas.bin -I $BASEDIR/include $file
 		if [ -n "$EMDAS" ] ; then
-			$EMDAS -c mx16 -na -o /tmp/emas.asm /tmp/emas.bin
+			$EMDAS -c mx16 -na -o /tmp/emas.asm $bin
 			$EMAS -Oraw -c mx16 -o /tmp/emas2.bin /tmp/emas.asm
-			cmp /tmp/emas.bin /tmp/emas2.bin
+			cmp $bin /tmp/emas2.bin
 		fi
 		if [ -n "$STABLE_EMAS" ] ; then
 			$STABLE_EMAS -I ../asminc -Oraw -o /tmp/emas_stable.bin -I $BASEDIR/include $file
-			cmp /tmp/emas.bin /tmp/emas_stable.bin
+			cmp $bin /tmp/emas_stable.bin
 		fi
 	done
 done
+rm -rf $OUTDIR
 echo
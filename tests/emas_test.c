@@ -0,0 +1,602 @@
+//  Copyright (c) 2026 Jakub Filipowicz <jakubf@gmail.com>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc.,
+//  51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "libemas.h"
+
+// em400 functional test directories (same as in asmtest.sh)
+static char *em400_dirs[] = {
+	"addr", "alu", "args", "barnb", "cycle", "int", "mem", "mod", "multix", "ops", "registers", "vendor", NULL
+};
+
+struct test_case {
+	char *source;
+	char *golden;		// expected output, NULL if the source only needs to assemble
+	int otype;
+	int jobs;			// encoding threads (from case options)
+	struct emas_variant *variants;	// variants to assemble (from case options)
+	int variant_count;
+	int passed;
+	double ms;
+	char *result;		// actual output (on failure)
+	size_t result_len;
+	int done;
+};
+
+struct test_case *cases;
+int case_count;
+int case_next;
+pthread_mutex_t case_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t case_cond = PTHREAD_COND_INITIALIZER;
+
+int verbose;
+int jobs = 4;
+char **em400_inc_paths;
+
+// -----------------------------------------------------------------------
+void usage()
+{
+	fprintf(stderr, "Usage: emas-test [options] [acceptance_dir ...]\n");
+	fprintf(stderr, "Where options are one or more of:\n");
+	fprintf(stderr, "   -j <n>         : use <n> worker threads (4 by default)\n");
+	fprintf(stderr, "   -e <dir>       : also assemble em400 functional tests from <dir>\n");
+	fprintf(stderr, "   -I <dir>       : search for include files in <dir> (em400 tests)\n");
+	fprintf(stderr, "   -v             : print all cases with timings, not only failures\n");
+	fprintf(stderr, "   -h             : print help and exit\n");
+}
+
+// -----------------------------------------------------------------------
+static double now_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// -----------------------------------------------------------------------
+static char * file_read(char *name, size_t *len)
+{
+	char *buf = NULL;
+	size_t size = 0;
+	char chunk[4096];
+	size_t res;
+
+	FILE *f = fopen(name, "r");
+	if (!f) {
+		return NULL;
+	}
+
+	FILE *m = open_memstream(&buf, &size);
+	while ((res = fread(chunk, 1, 4096, f)) > 0) {
+		fwrite(chunk, 1, res, m);
+	}
+	fclose(m);
+	fclose(f);
+
+	*len = size;
+
+	return buf;
+}
+
+// -----------------------------------------------------------------------
+static int str_sort(const void *a, const void *b)
+{
+	return strcmp(*(char**)a, *(char**)b);
+}
+
+// -----------------------------------------------------------------------
+// Get sorted names of directory entries with given suffix
+// (or subdirectories if suffix is NULL)
+static char ** dir_list(char *dir, char *suffix)
+{
+	char **list = NULL;
+	int count = 0;
+	struct dirent *de;
+	struct stat st;
+	char path[4096];
+
+	DIR *d = opendir(dir);
+	if (!d) {
+		return NULL;
+	}
+
+	while ((de = readdir(d))) {
+		if (de->d_name[0] == '.') continue;
+		snprintf(path, 4096, "%s/%s", dir, de->d_name);
+		if (stat(path, &st)) continue;
+		if (suffix) {
+			int l = strlen(de->d_name);
+			int sl = strlen(suffix);
+			if (!S_ISREG(st.st_mode) || (l <= sl) || strcmp(de->d_name+l-sl, suffix)) continue;
+		} else if (!S_ISDIR(st.st_mode)) {
+			continue;
+		}
+		emas_list_add(&list, path);
+		count++;
+	}
+	closedir(d);
+
+	if (list) {
+		qsort(list, count, sizeof(char*), str_sort);
+	}
+
+	return list;
+}
+
+// -----------------------------------------------------------------------
+static int case_add(char *source, char *golden, int otype)
+{
+	struct test_case *c = realloc(cases, (case_count+1) * sizeof(struct test_case));
+	if (!c) {
+		return -1;
+	}
+	cases = c;
+	c += case_count;
+	memset(c, 0, sizeof(struct test_case));
+	c->source = strdup(source);
+	c->golden = golden ? strdup(golden) : NULL;
+	c->otype = otype;
+	case_count++;
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Add a variant given as "name:opt,opt,...", where each option
+// is either -D<const>[=v] or -c<cpu> (same as emas -V)
+static int case_variant_add(struct test_case *c, char *spec)
+{
+	char *opt, *next;
+	char *colon = strchr(spec, ':');
+	int len = colon ? colon-spec : strlen(spec);
+
+	if (!len) {
+		return -1;
+	}
+
+	struct emas_variant *v = realloc(c->variants, (c->variant_count+1) * sizeof(struct emas_variant));
+	if (!v) {
+		return -1;
+	}
+	c->variants = v;
+	v += c->variant_count;
+	c->variant_count++;
+	memset(v, 0, sizeof(struct emas_variant));
+	v->name = strndup(spec, len);
+
+	for (opt=colon ? colon+1 : NULL ; opt ; opt=next) {
+		next = strchr(opt, ',');
+		if (next) {
+			*next++ = '\0';
+		}
+		if (!strncmp(opt, "-D", 2) && opt[2]) {
+			emas_list_add(&v->defs, opt+2);
+		} else if (!strncmp(opt, "-c", 2)) {
+			v->cpu = cpu_by_name(opt+2);
+			if (v->cpu == CPU_DEFAULT) {
+				return -1;
+			}
+		} else {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Read case options given in "; emas-test: <options>" lines
+// at the top of the source. Options are:
+//   -j <n>                : encode using <n> threads
+//   -V <name>:<opts>      : assemble a variant (same as emas -V, but no spaces)
+// If there are variants, all of them are assembled from a single parse
+// and then each one separately, outputs need to be the same.
+static int case_options(struct test_case *c)
+{
+	char line[1024];
+	char *save;
+	int ret = 0;
+
+	FILE *f = fopen(c->source, "r");
+	if (!f) {
+		return 0; // let the assembler report it
+	}
+
+	while (!ret && fgets(line, 1024, f) && !strncmp(line, "; emas-test:", 12)) {
+		char *opt = strtok_r(line+12, " \t\n", &save);
+		while (!ret && opt) {
+			char *arg = strtok_r(NULL, " \t\n", &save);
+			if (!strcmp(opt, "-j") && arg && (atoi(arg) > 0)) {
+				c->jobs = atoi(arg);
+			} else if (!strcmp(opt, "-V") && arg) {
+				ret = case_variant_add(c, arg);
+			} else {
+				ret = -1;
+			}
+			opt = strtok_r(NULL, " \t\n", &save);
+		}
+	}
+	fclose(f);
+
+	if (ret) {
+		fprintf(stderr, "Wrong test case options in: '%s'\n", c->source);
+	}
+
+	return ret;
+}
+
+// -----------------------------------------------------------------------
+// Add acceptance cases: <dir>/<group>/<name>.asm with <name>.out golden files
+static int add_acceptance(char *dir)
+{
+	char **groups = dir_list(dir, NULL);
+	char **g, **s;
+
+	if (!groups) {
+		fprintf(stderr, "Cannot read acceptance tests directory: '%s'\n", dir);
+		return -1;
+	}
+
+	for (g=groups ; *g ; g++) {
+		char **sources = dir_list(*g, ".asm");
+		if (!sources) {
+			fprintf(stderr, "Missing tests in: '%s'\n", *g);
+			emas_list_free(groups);
+			return -1;
+		}
+		for (s=sources ; *s ; s++) {
+			char *golden = strdup(*s);
+			strcpy(golden + strlen(golden) - 4, ".out");
+			int res = case_add(*s, golden, O_DEBUG) || case_options(cases + case_count - 1);
+			free(golden);
+			if (res) {
+				emas_list_free(sources);
+				emas_list_free(groups);
+				return -1;
+			}
+		}
+		emas_list_free(sources);
+	}
+
+	emas_list_free(groups);
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Add em400 functional tests: <dir>/functional/<group>/*.asm
+static int add_em400(char *dir)
+{
+	char path[4096];
+	char **g, **s;
+
+	snprintf(path, 4096, "%s/include", dir);
+	emas_list_add(&em400_inc_paths, path);
+
+	for (g=em400_dirs ; *g ; g++) {
+		snprintf(path, 4096, "%s/functional/%s", dir, *g);
+		char **sources = dir_list(path, ".asm");
+		if (!sources) {
+			fprintf(stderr, "Missing tests in: '%s'\n", path);
+			return -1;
+		}
+		for (s=sources ; *s ; s++) {
+			case_add(*s, NULL, O_RAW);
+		}
+		emas_list_free(sources);
+	}
+
+	return 0;
+}
+
+// -----------------------------------------------------------------------
+// Assemble all variants from a single parse, then each one separately.
+// Diagnostics and variant outputs go to the case output.
+// Returns 1 if variants differ from separate runs.
+static int case_run_variants(struct emas_ctx *ctx, struct test_case *c, struct emas_opts *opts, FILE *f)
+{
+	int n = c->variant_count;
+	char *err[2] = { NULL, NULL };
+	size_t err_len[2] = { 0, 0 };
+	char **buf = calloc(2 * n, sizeof(char*));
+	size_t *len = calloc(2 * n, sizeof(size_t));
+	int differ = 0;
+
+	if (!buf || !len) {
+		fprintf(f, "Cannot allocate memory for variant outputs\n");
+		free(buf);
+		free(len);
+		return 1;
+	}
+
+	// all variants at once
+	opts->errf = open_memstream(err, err_len);
+	for (int i=0 ; i<n ; i++) {
+		struct emas_out out = { c->otype, "(memory)", open_memstream(buf+i, len+i) };
+		c->variants[i].out = out;
+	}
+	emas_assemble_variants(ctx, c->source, opts, c->variants, n);
+	for (int i=0 ; i<n ; i++) {
+		fclose(c->variants[i].out.f);
+	}
+	fclose(opts->errf);
+
+	// each variant separately
+	opts->errf = open_memstream(err+1, err_len+1);
+	for (int i=0 ; i<n ; i++) {
+		struct emas_variant *v = c->variants + i;
+		struct emas_out out = { c->otype, "(memory)", open_memstream(buf+n+i, len+n+i) };
+		opts->cpu = v->cpu;
+		opts->defs = v->defs;
+		if (emas_assemble(ctx, c->source, opts, &out)) {
+			fprintf(opts->errf, "Variant '%s' failed.\n", v->name);
+		}
+		fclose(out.f);
+	}
+	fclose(opts->errf);
+
+	fwrite(err[0], 1, err_len[0], f);
+	differ = (err_len[0] != err_len[1]) || memcmp(err[0], err[1], err_len[0]);
+	for (int i=0 ; i<n ; i++) {
+		fprintf(f, "---- %s\n", c->variants[i].name);
+		fwrite(buf[i], 1, len[i], f);
+		differ |= (len[i] != len[n+i]) || memcmp(buf[i], buf[n+i], len[i]);
+	}
+	if (differ) {
+		fprintf(f, "Variants differ from separate runs\n");
+	}
+
+	for (int i=0 ; i<2*n ; i++) {
+		free(buf[i]);
+	}
+	free(buf);
+	free(len);
+	free(err[0]);
+	free(err[1]);
+
+	return differ;
+}
+
+// -----------------------------------------------------------------------
+static void case_run(struct emas_ctx *ctx, struct test_case *c)
+{
+	char *buf = NULL;
+	size_t len = 0;
+	size_t glen = 0;
+	char *golden = NULL;
+
+	double start = now_ms();
+
+	// output and diagnostics are collected together,
+	// just like run_test.sh does with "&>"
+	FILE *f = open_memstream(&buf, &len);
+	struct emas_opts opts = { 0 };
+	opts.errf = f;
+	opts.inc_paths = c->golden ? NULL : em400_inc_paths;
+	opts.jobs = c->jobs;
+	struct emas_out out = { c->otype, "(memory)", f };
+
+	int res;
+	if (c->variant_count) {
+		res = case_run_variants(ctx, c, &opts, f);
+	} else {
+		res = emas_assemble(ctx, c->source, &opts, &out);
+	}
+	fclose(f);
+
+	if (c->golden) {
+		golden = file_read(c->golden, &glen);
+		c->passed = golden && (glen == len) && !memcmp(golden, buf, len);
+		if (c->variant_count && res) {
+			c->passed = 0;
+		}
+	} else {
+		c->passed = !res;
+	}
+
+	c->ms = now_ms() - start;
+
+	if (c->passed) {
+		free(buf);
+	} else {
+		c->result = buf;
+		c->result_len = len;
+	}
+	free(golden);
+}
+
+// -----------------------------------------------------------------------
+static void * worker(void *ptr)
+{
+	int i;
+	struct emas_ctx *ctx = emas_create();
+
+	while (1) {
+		pthread_mutex_lock(&case_lock);
+		i = case_next++;
+		pthread_mutex_unlock(&case_lock);
+
+		if (i >= case_count) {
+			break;
+		}
+
+		if (ctx) {
+			case_run(ctx, cases+i);
+		}
+
+		pthread_mutex_lock(&case_lock);
+		cases[i].done = 1;
+		pthread_cond_broadcast(&case_cond);
+		pthread_mutex_unlock(&case_lock);
+	}
+
+	emas_destroy(ctx);
+
+	return NULL;
+}
+
+// -----------------------------------------------------------------------
+static void case_report(struct test_case *c)
+{
+	if (c->passed) {
+		if (verbose) {
+			printf("PASS %9.3f ms  %s\n", c->ms, c->source);
+		}
+		return;
+	}
+
+	printf("FAIL %9.3f ms  %s\n", c->ms, c->source);
+
+	if (c->golden) {
+		size_t glen;
+		char *golden = file_read(c->golden, &glen);
+		if (!golden) {
+			printf("     cannot read golden file: %s\n", c->golden);
+		} else {
+			printf("     --- expected (%s):\n", c->golden);
+			fwrite(golden, 1, glen, stdout);
+			printf("     --- got:\n");
+		}
+		free(golden);
+	}
+	fwrite(c->result, 1, c->result_len, stdout);
+}
+
+// -----------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+	int option;
+	int i;
+	int failed = 0;
+	double cpu_ms = 0;
+	char *em400_dir = NULL;
+	char **inc_paths = NULL;
+
+	while ((option = getopt(argc, argv, "j:e:I:vh")) != -1) {
+		switch (option) {
+			case 'j':
+				jobs = atoi(optarg);
+				if (jobs < 1) {
+					fprintf(stderr, "Wrong number of jobs: '%s'.\n", optarg);
+					return 1;
+				}
+				break;
+			case 'e':
+				em400_dir = optarg;
+				break;
+			case 'I':
+				emas_list_add(&inc_paths, optarg);
+				break;
+			case 'v':
+				verbose = 1;
+				break;
+			case 'h':
+				usage();
+				return 0;
+			default:
+				usage();
+				return 1;
+		}
+	}
+
+	if (emas_init() < 0) {
+		fprintf(stderr, "Internal dictionary initialization failed.\n");
+		return 1;
+	}
+
+	for (i=optind ; i<argc ; i++) {
+		if (add_acceptance(argv[i])) {
+			return 1;
+		}
+	}
+
+	if (em400_dir) {
+		char **s;
+		for (s=inc_paths ; s && *s ; s++) {
+			emas_list_add(&em400_inc_paths, *s);
+		}
+		if (add_em400(em400_dir)) {
+			return 1;
+		}
+	}
+
+	if (!case_count) {
+		fprintf(stderr, "No tests given.\n\n");
+		usage();
+		return 1;
+	}
+
+	double start = now_ms();
+
+	if (jobs > case_count) jobs = case_count;
+	pthread_t *threads = calloc(jobs, sizeof(pthread_t));
+	for (i=0 ; i<jobs ; i++) {
+		pthread_create(threads+i, NULL, worker, NULL);
+	}
+
+	// report in order, as results come in
+	for (i=0 ; i<case_count ; i++) {
+		pthread_mutex_lock(&case_lock);
+		while (!cases[i].done) {
+			pthread_cond_wait(&case_cond, &case_lock);
+		}
+		pthread_mutex_unlock(&case_lock);
+
+		case_report(cases+i);
+		cpu_ms += cases[i].ms;
+		if (!cases[i].passed) {
+			failed++;
+		}
+	}
+
+	for (i=0 ; i<jobs ; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	printf("%i cases, %i passed, %i failed (%.3f ms, %.3f ms in cases, %i workers)\n",
+		case_count, case_count-failed, failed, now_ms() - start, cpu_ms, jobs);
+
+	for (i=0 ; i<case_count ; i++) {
+		free(cases[i].source);
+		free(cases[i].golden);
+		free(cases[i].result);
+		for (int j=0 ; j<cases[i].variant_count ; j++) {
+			free(cases[i].variants[j].name);
+			emas_list_free(cases[i].variants[j].defs);
+		}
+		free(cases[i].variants);
+	}
+	free(cases);
+	free(threads);
+	emas_list_free(inc_paths);
+	emas_list_free(em400_inc_paths);
+	emas_shutdown();
+
+	return failed ? 1 : 0;
+}
+
+// vim: tabstop=4 autoindent
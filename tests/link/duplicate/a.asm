@@ -0,0 +1,4 @@
+	.global	start
+	.global	func
+start:	rj	r4, func
+	hlt	077
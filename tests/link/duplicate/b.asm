@@ -0,0 +1,4 @@
+	.global	start
+	.global	func
+func:	lw	r1, 1
+start:	uj	r4
@@ -0,0 +1,15 @@
+	.global	func
+	.global	table
+	.global	start
+start:
+	lw	r1, table+2
+	rj	r4, func
+	lw	r2, [tab_ptr]
+	ujs	.loop
+.loop:	hlt	077
+	uj	start
+tab_ptr: .word table, func-1, local_data, 5
+local_data: .word -1, end-start
+	.res 3
+	.res 2, 0x1234
+end:
@@ -0,0 +1,10 @@
+	.global	func
+	.global	table
+	.global	start
+	.const	size 4
+func:
+	lw	r1, size
+	uj	[start]
+	uj	r4
+table:	.word 1, 2, 3, table+size
+	.res 10
@@ -0,0 +1,5 @@
+	.global	start
+	.global	func
+start:	lw	r1, end-start
+	rj	r4, func
+end:	hlt	077
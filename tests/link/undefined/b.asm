@@ -0,0 +1,4 @@
+	.global	func
+	.global	data
+func:	lw	r1, [data]
+	uj	r4
@@ -0,0 +1,52 @@
+#!/bin/bash
+
+# Each directory in link/ is a test case. Its modules (all *.asm files
+# but expected.asm) are assembled with -O obj and linked with emld
+# in name order. The image needs to be the same as the one assembled
+# from expected.asm, or the linker needs to fail with expected.err message.
+
+EMAS=$(readlink -f ${1:-../build/emas})
+EMLD=$(readlink -f ${2:-../build/emld})
+DIFF="diff --color "
+OUTDIR=$(mktemp -d)
+FAILED=0
+
+for d in $(find link -mindepth 1 -maxdepth 1 -type d | sort) ; do
+	echo $d
+	rm -f $OUTDIR/*
+	objs=""
+	for f in $(ls -1 $d/*.asm | grep -v '/expected\.asm$') ; do
+		obj=$(basename $f .asm).o
+		if ! $EMAS -O obj -o $OUTDIR/$obj $f ; then
+			FAILED=1
+			continue 2
+		fi
+		objs="$objs $obj"
+	done
+	(cd $OUTDIR && $EMLD -o linked.bin $objs 2> linked.err)
+	res=$?
+	if [ -f $d/expected.err ] ; then
+		if [ $res == 0 ] ; then
+			echo "Linking should fail"
+			FAILED=1
+		elif ! $DIFF $d/expected.err $OUTDIR/linked.err ; then
+			FAILED=1
+		fi
+	elif [ $res != 0 ] ; then
+		cat $OUTDIR/linked.err
+		FAILED=1
+	elif ! $EMAS -O raw -o $OUTDIR/expected.bin $d/expected.asm ; then
+		FAILED=1
+	elif ! cmp $OUTDIR/expected.bin $OUTDIR/linked.bin ; then
+		FAILED=1
+	fi
+done
+
+rm -rf $OUTDIR
+
+if [ $FAILED != 0 ] ; then
+	echo "Ooops."
+	exit 1
+fi
+
+echo "PASSED"